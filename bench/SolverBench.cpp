@@ -0,0 +1,327 @@
+#include "BFSSolver.h"
+#include "BidirectionalDijkstraSolver.h"
+#include "BlockAStarSolver.h"
+#include "DijkstraSolver.h"
+#include "MazeGenerator.h"
+#include "MazeSolverStrategy.h"
+#include "SolverKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct BenchCase {
+        std::string label;
+        Maze maze;
+    };
+
+    struct Timing {
+        double millis;
+        double cost;
+        int nodes;
+    };
+
+    Timing timeStrategy(MazeSolverStrategy& strategy, const Maze& maze, int repetitions) {
+        Timing timing = {0.0, 0.0, 0};
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++) {
+            Path path = strategy.solve(maze);
+            timing.cost = path.getCost();
+        }
+        auto end = std::chrono::steady_clock::now();
+        timing.millis = std::chrono::duration<double, std::milli>(end - begin).count() / repetitions;
+        timing.nodes = strategy.getNodesExplored();
+        return timing;
+    }
+
+    void printRow(const std::string& name, const Timing& timing, double baselineMillis) {
+        std::cout << "  " << std::left << std::setw(34) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(3) << timing.millis << " ms"
+                  << std::setw(10) << std::setprecision(0) << timing.cost
+                  << std::setw(10) << timing.nodes
+                  << std::setw(9) << std::setprecision(2) << baselineMillis / timing.millis << "x\n";
+    }
+
+    bool sameCost(const Timing& a, const Timing& b) {
+        return std::fabs(a.cost - b.cost) < 1e-9;
+    }
+
+    void benchKernels(const std::vector<BenchCase>& cases, int repetitions) {
+        std::cout << "\n=== Specialized kernels vs virtual solvers ===\n";
+        std::cout << "  " << std::left << std::setw(34) << "solver"
+                  << std::right << std::setw(13) << "time" << std::setw(10) << "cost"
+                  << std::setw(10) << "nodes" << std::setw(10) << "speedup\n";
+
+        for (const auto& bench : cases) {
+            std::cout << "\n" << bench.label << " (" << bench.maze.getWidth() << "x" << bench.maze.getHeight() << ")\n";
+
+            BFSSolver bfs;
+            FastBFSSolver fastBfs;
+            Timing bfsTime = timeStrategy(bfs, bench.maze, repetitions);
+            Timing fastBfsTime = timeStrategy(fastBfs, bench.maze, repetitions);
+            printRow(bfs.name(), bfsTime, bfsTime.millis);
+            printRow(fastBfs.name(), fastBfsTime, bfsTime.millis);
+
+            DijkstraSolver dijkstra;
+            FastDijkstraSolver fastDijkstra;
+            BucketDijkstraSolver bucketDijkstra;
+            Timing dijkstraTime = timeStrategy(dijkstra, bench.maze, repetitions);
+            Timing fastDijkstraTime = timeStrategy(fastDijkstra, bench.maze, repetitions);
+            Timing bucketTime = timeStrategy(bucketDijkstra, bench.maze, repetitions);
+            printRow(dijkstra.name(), dijkstraTime, dijkstraTime.millis);
+            printRow(fastDijkstra.name(), fastDijkstraTime, dijkstraTime.millis);
+            printRow(bucketDijkstra.name(), bucketTime, dijkstraTime.millis);
+
+            if (!sameCost(bfsTime, fastBfsTime) || !sameCost(dijkstraTime, fastDijkstraTime) ||
+                !sameCost(dijkstraTime, bucketTime)) {
+                std::cout << "  !! cost mismatch between kernel and reference solver\n";
+            }
+        }
+    }
+
+    void benchBlocks(const std::vector<BenchCase>& cases, int repetitions) {
+        std::cout << "\n=== Block A* vs BFS (unit-cost path lengths) ===\n";
+
+        for (const auto& bench : cases) {
+            std::cout << "\n" << bench.label << " (" << bench.maze.getWidth() << "x" << bench.maze.getHeight() << ")\n";
+
+            BFSSolver bfs;
+            BlockAStarSolver blockAStar;
+            Timing bfsTime = timeStrategy(bfs, bench.maze, repetitions);
+            Timing blockTime = timeStrategy(blockAStar, bench.maze, repetitions);
+            printRow(bfs.name(), bfsTime, bfsTime.millis);
+            printRow(blockAStar.name(), blockTime, bfsTime.millis);
+            if (blockAStar.usedFallback()) {
+                DijkstraSolver dijkstra;
+                std::cout << "  non-uniform costs: delegated to Dijkstra\n";
+                if (!sameCost(timeStrategy(dijkstra, bench.maze, 1), blockTime)) {
+                    std::cout << "  !! cost mismatch between Block A* fallback and Dijkstra\n";
+                }
+                continue;
+            }
+            std::cout << "  heap operations: " << blockAStar.getHeapOperations()
+                      << ", local tables: " << blockAStar.getLocalTablesComputed() << "\n";
+
+            if (!sameCost(bfsTime, blockTime)) {
+                std::cout << "  !! path length mismatch between Block A* and BFS\n";
+            }
+        }
+    }
+
+    void benchStorage(const std::vector<BenchCase>& cases, int repetitions) {
+        std::cout << "\n=== Byte vs packed cell storage ===\n";
+
+        for (const auto& bench : cases) {
+            std::cout << "\n" << bench.label << " (" << bench.maze.getWidth() << "x" << bench.maze.getHeight() << ")\n";
+
+            Maze packed = bench.maze;
+            if (!packed.setStorage(CellStorage::Packed)) {
+                std::cout << "  palette too large to pack\n";
+                continue;
+            }
+
+            FastDijkstraSolver bytesSolver;
+            FastDijkstraSolver packedSolver;
+            Timing bytesTime = timeStrategy(bytesSolver, bench.maze, repetitions);
+            Timing packedTime = timeStrategy(packedSolver, packed, repetitions);
+            printRow("Dijkstra kernel, 8 bits/cell", bytesTime, bytesTime.millis);
+            printRow("Dijkstra kernel, " + std::to_string(packed.getBitsPerCell()) + " bits/cell",
+                     packedTime, bytesTime.millis);
+            std::cout << "  storage: " << bench.maze.getStorageBytes() << " -> " << packed.getStorageBytes() << " bytes\n";
+
+            if (!sameCost(bytesTime, packedTime)) {
+                std::cout << "  !! cost mismatch between storage backends\n";
+            }
+        }
+    }
+
+    // Random cell probes, the access pattern of a search that has left its
+    // neighbourhood. Returns milliseconds; the count keeps the loop alive.
+    double timeProbes(const Maze& maze, int probes, long& walkable) {
+        const unsigned width = static_cast<unsigned>(maze.getWidth());
+        const unsigned height = static_cast<unsigned>(maze.getHeight());
+        unsigned seed = 2024;
+        walkable = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < probes; i++) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned roll = seed ^ (seed >> 13);
+            walkable += maze.isWalkableAtIndex(maze.cellIndex(static_cast<int>(roll % width),
+                                                              static_cast<int>((roll / width) % height)));
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    // The grids above fit in L2 either way; this one does not fit as bytes
+    // plus open masks (24 MiB) nor packed at 2 bits (4 MiB).
+    void benchStorageOutOfCache(const BenchCase& bench, int repetitions) {
+        std::cout << "\n=== Byte vs packed cell storage, out of cache ===\n";
+        std::cout << "\n" << bench.label << " (" << bench.maze.getWidth() << "x" << bench.maze.getHeight() << ")\n";
+
+        Maze packed = bench.maze;
+        if (!packed.setStorage(CellStorage::Packed)) {
+            std::cout << "  palette too large to pack\n";
+            return;
+        }
+        std::cout << "  storage: " << bench.maze.getStorageBytes() << " -> " << packed.getStorageBytes()
+                  << " bytes (" << packed.getBitsPerCell() << " bits/cell)\n";
+
+        const int probes = 4000000;
+        long bytesWalkable = 0;
+        long packedWalkable = 0;
+        double bytesMillis = 0.0;
+        double packedMillis = 0.0;
+        for (int i = 0; i < repetitions; i++) {
+            bytesMillis += timeProbes(bench.maze, probes, bytesWalkable);
+            packedMillis += timeProbes(packed, probes, packedWalkable);
+        }
+        Timing bytesProbe = {bytesMillis / repetitions, static_cast<double>(bytesWalkable), probes};
+        Timing packedProbe = {packedMillis / repetitions, static_cast<double>(packedWalkable), probes};
+        printRow("random probes, 8 bits/cell", bytesProbe, bytesProbe.millis);
+        printRow("random probes, packed", packedProbe, bytesProbe.millis);
+
+        BFSSolver bytesBfs;
+        BFSSolver packedBfs;
+        Timing bytesBfsTime = timeStrategy(bytesBfs, bench.maze, repetitions);
+        Timing packedBfsTime = timeStrategy(packedBfs, packed, repetitions);
+        printRow("BFS, 8 bits/cell", bytesBfsTime, bytesBfsTime.millis);
+        printRow("BFS, packed", packedBfsTime, bytesBfsTime.millis);
+
+        FastDijkstraSolver bytesDijkstra;
+        FastDijkstraSolver packedDijkstra;
+        Timing bytesDijkstraTime = timeStrategy(bytesDijkstra, bench.maze, repetitions);
+        Timing packedDijkstraTime = timeStrategy(packedDijkstra, packed, repetitions);
+        printRow("Dijkstra kernel, 8 bits/cell", bytesDijkstraTime, bytesDijkstraTime.millis);
+        printRow("Dijkstra kernel, packed", packedDijkstraTime, bytesDijkstraTime.millis);
+
+        if (!sameCost(bytesProbe, packedProbe) || !sameCost(bytesBfsTime, packedBfsTime) ||
+            !sameCost(bytesDijkstraTime, packedDijkstraTime)) {
+            std::cout << "  !! result mismatch between storage backends\n";
+        }
+    }
+
+    void benchBidirectional(const std::vector<BenchCase>& cases, int repetitions) {
+        std::cout << "\n=== Bidirectional vs unidirectional Dijkstra ("
+                  << std::thread::hardware_concurrency() << " hardware threads) ===\n";
+
+        for (const auto& bench : cases) {
+            std::cout << "\n" << bench.label << " (" << bench.maze.getWidth() << "x" << bench.maze.getHeight() << ")\n";
+
+            DijkstraSolver dijkstra;
+            Timing dijkstraTime = timeStrategy(dijkstra, bench.maze, repetitions);
+            printRow(dijkstra.name(), dijkstraTime, dijkstraTime.millis);
+
+            for (int threaded = 0; threaded < 2; threaded++) {
+                BidirectionalDijkstraSolver bidirectional;
+                bidirectional.setThreaded(threaded == 1);
+                Timing bidirectionalTime = timeStrategy(bidirectional, bench.maze, repetitions);
+                printRow(bidirectional.name(), bidirectionalTime, dijkstraTime.millis);
+
+                if (!sameCost(dijkstraTime, bidirectionalTime)) {
+                    std::cout << "  !! cost mismatch between bidirectional and plain Dijkstra\n";
+                }
+            }
+        }
+    }
+
+    // Wide, short cave maze. The recursive generator cannot reach 8k columns,
+    // so walls and water are scattered directly with a small LCG.
+    Maze makeWideCave(int width, int height, unsigned seed) {
+        Maze maze(width, height);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                seed = seed * 1103515245u + 12345u;
+                int roll = static_cast<int>((seed >> 16) % 100);
+                if (roll < 25) {
+                    maze.setCellAt(x, y, '#');
+                } else if (roll < 35) {
+                    maze.setCellAt(x, y, '~');
+                }
+            }
+        }
+        for (int d = 0; d < 3; d++) {
+            for (int e = 0; e < 3; e++) {
+                maze.setCellAt(d, e, '.');
+                maze.setCellAt(width - 1 - d, height - 1 - e, '.');
+            }
+        }
+        maze.setStart(Point(0, 0));
+        maze.setGoal(Point(width - 1, height - 1));
+        return maze;
+    }
+
+    template <typename Layout>
+    class LayoutBFS : public KernelSolver<UniformCost, FifoFrontier<int>, StopAtGoal, Layout> {
+    public:
+        std::string name() const override {
+            return std::string("BFS kernel, ") + Layout::name();
+        }
+    };
+
+    template <typename Layout>
+    class LayoutDijkstra : public KernelSolver<TerrainCost, HeapFrontier<double>, StopAtGoal, Layout> {
+    public:
+        std::string name() const override {
+            return std::string("Dijkstra kernel, ") + Layout::name();
+        }
+    };
+
+    void benchLayouts(const std::vector<BenchCase>& cases, int repetitions) {
+        std::cout << "\n=== Row-major vs 8x8 tiled state arrays (maze grid: "
+                  << CellLayout::name() << ") ===\n";
+
+        for (const auto& bench : cases) {
+            std::cout << "\n" << bench.label << " (" << bench.maze.getWidth() << "x" << bench.maze.getHeight() << ")\n";
+
+            LayoutBFS<RowMajorLayout> rowBfs;
+            LayoutBFS<TiledLayout<3>> tiledBfs;
+            Timing rowBfsTime = timeStrategy(rowBfs, bench.maze, repetitions);
+            Timing tiledBfsTime = timeStrategy(tiledBfs, bench.maze, repetitions);
+            printRow(rowBfs.name(), rowBfsTime, rowBfsTime.millis);
+            printRow(tiledBfs.name(), tiledBfsTime, rowBfsTime.millis);
+
+            LayoutDijkstra<RowMajorLayout> rowDijkstra;
+            LayoutDijkstra<TiledLayout<3>> tiledDijkstra;
+            Timing rowDijkstraTime = timeStrategy(rowDijkstra, bench.maze, repetitions);
+            Timing tiledDijkstraTime = timeStrategy(tiledDijkstra, bench.maze, repetitions);
+            printRow(rowDijkstra.name(), rowDijkstraTime, rowDijkstraTime.millis);
+            printRow(tiledDijkstra.name(), tiledDijkstraTime, rowDijkstraTime.millis);
+
+            if (!sameCost(rowBfsTime, tiledBfsTime) || !sameCost(rowDijkstraTime, tiledDijkstraTime)) {
+                std::cout << "  !! cost mismatch between layouts\n";
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int repetitions = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+    std::vector<BenchCase> cases;
+    MazeGenerator generator(201, 201, 4242);
+    cases.push_back(BenchCase{"Perfect maze", generator.generatePerfect()});
+    cases.push_back(BenchCase{"Looped maze", generator.generateWithLoops(4000)});
+    generator.setDimensions(401, 401);
+    cases.push_back(BenchCase{"Terrain maze", generator.generateWithTerrain(15, 8)});
+
+    benchKernels(cases, repetitions);
+    benchBlocks(cases, repetitions);
+    benchStorage(cases, repetitions);
+    benchBidirectional(cases, repetitions);
+
+    std::vector<BenchCase> wide;
+    wide.push_back(BenchCase{"Wide cave", makeWideCave(8192, 256, 77)});
+    wide.push_back(BenchCase{"Wider cave", makeWideCave(16384, 128, 91)});
+    benchLayouts(wide, repetitions);
+
+    benchStorageOutOfCache(BenchCase{"Large cave", makeWideCave(4096, 4096, 53)}, repetitions);
+    return 0;
+}
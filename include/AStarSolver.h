@@ -0,0 +1,24 @@
+#ifndef ASTARSOLVER_H
+#define ASTARSOLVER_H
+
+#include "IncrementalSolver.h"
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include <string>
+
+
+class AStarSolver : public MazeSolverStrategy {
+private:
+    IncrementalAStar search_;
+    int nodesExplored_;
+
+public:
+    AStarSolver();
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
+    int getNodesExplored() const override;
+    std::string name() const override;
+};
+
+#endif
@@ -31,7 +31,7 @@ private:
 public:
     BFSSolver();
 
-    Path solve(const Maze& maze) override;
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
     int getNodesExplored() const override;
     std::string name() const override;
 };
@@ -0,0 +1,87 @@
+#ifndef BIDIRECTIONALDIJKSTRASOLVER_H
+#define BIDIRECTIONALDIJKSTRASOLVER_H
+
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include "SolveOptions.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+class BidirectionalDijkstraSolver : public MazeSolverStrategy {
+private:
+    typedef std::pair<double, int> QueueItem;
+    typedef std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> Queue;
+
+    struct Side {
+        Queue heap;
+        std::unique_ptr<std::atomic<double>[]> distance;
+        std::size_t capacity = 0;
+        std::vector<int> parent;
+        std::vector<int> touched;
+        std::atomic<double> top;
+        int nodesExplored;
+        SolveStatus stopStatus;
+        bool stopped;
+    };
+
+    Side forward_;
+    Side backward_;
+    std::atomic<double> bestCost_;
+    std::atomic<bool> abort_;
+    int meetingCell_;
+    std::mutex meetingMutex_;
+    int nodesExplored_;
+    bool threaded_;
+    // Set only while a search with an allowed-cells mask runs.
+    const SolveOptions* restriction_;
+
+    // The backward search runs on one long-lived helper thread rather than
+    // a thread spawned per query.
+    std::thread helper_;
+    std::mutex helperMutex_;
+    std::condition_variable helperWake_;
+    std::condition_variable helperDone_;
+    const Maze* helperMaze_;
+    const SolveOptions* helperOptions_;
+    bool helperPending_;
+    bool helperStopping_;
+
+    void prepare(const Maze& maze);
+    bool expand(const Maze& maze, bool isForward, SolveBudget& budget);
+    void search(const Maze& maze, bool isForward, const SolveOptions& options);
+    void searchInterleaved(const Maze& maze, const SolveOptions& options);
+    bool isAllowed(const Maze& maze, int cell) const;
+    void offerMeeting(double cost, int cell);
+    void settleMeeting();
+    Path reconstruct(const Maze& maze) const;
+    void helperLoop();
+
+public:
+    BidirectionalDijkstraSolver();
+    ~BidirectionalDijkstraSolver();
+
+    BidirectionalDijkstraSolver(const BidirectionalDijkstraSolver&) = delete;
+    BidirectionalDijkstraSolver& operator=(const BidirectionalDijkstraSolver&) = delete;
+
+    // Two threads by default on multi-core machines; otherwise both
+    // directions alternate on the calling thread.
+    void setThreaded(bool threaded);
+    bool isThreaded() const;
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
+    int getNodesExplored() const override;
+    std::string name() const override;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef BLOCKASTARSOLVER_H
+#define BLOCKASTARSOLVER_H
+
+#include "DijkstraSolver.h"
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class LocalDistanceTable {
+public:
+    static const int kBlockSize = 4;
+    static const int kCells = kBlockSize * kBlockSize;
+    static const unsigned char kUnreachable = 255;
+
+    const unsigned char* lookup(std::uint16_t wallMask);
+    int getComputedCount() const;
+
+private:
+    std::vector<std::unique_ptr<unsigned char[]>> tables_;
+    int computed_ = 0;
+
+    static void compute(std::uint16_t wallMask, unsigned char* table);
+};
+
+
+class BlockAStarSolver : public MazeSolverStrategy {
+private:
+    int width_;
+    int height_;
+    int blocksX_;
+    int blocksY_;
+
+    LocalDistanceTable localDistances_;
+    std::vector<std::uint16_t> wallMasks_;
+    std::vector<std::uint16_t> pending_;
+    std::vector<int> blockKey_;
+    std::vector<int> g_;
+    std::vector<int> parent_;
+    int nodesExplored_;
+    long long heapOperations_;
+    DijkstraSolver fallback_;
+    bool usedFallback_;
+
+    int blockOf(int x, int y) const;
+    int localOf(int x, int y) const;
+    int cellOf(int block, int local) const;
+    void loadBlocks(const Maze& maze);
+    Path reconstruct(const Point& start, const Point& goal, double stepCost);
+
+public:
+    BlockAStarSolver();
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
+    int getNodesExplored() const override;
+    std::string name() const override;
+
+    long long getHeapOperations() const;
+    int getLocalTablesComputed() const;
+    bool usedFallback() const;
+};
+
+#endif
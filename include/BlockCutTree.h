@@ -0,0 +1,49 @@
+#ifndef BLOCKCUTTREE_H
+#define BLOCKCUTTREE_H
+
+#include "Maze.h"
+#include "Point.h"
+#include "SolveOptions.h"
+#include <memory>
+#include <vector>
+
+
+class BlockCutTree {
+private:
+    int width_;
+    int height_;
+    bool built_;
+
+    std::vector<int> blockOfCell_;
+    std::vector<int> cutOfCell_;
+    std::vector<int> blockOffsets_;
+    std::vector<int> blockCells_;
+    std::vector<int> articulationCells_;
+
+    std::vector<int> treeParent_;
+    std::vector<int> treeDepth_;
+    std::vector<int> treeRoot_;
+
+    int blockCount() const;
+    int treeNodeOf(int cell) const;
+    void findBlocks(const Maze& maze);
+    void buildTree();
+
+public:
+    BlockCutTree();
+
+    bool build(const Maze& maze);
+    bool isBuilt() const;
+    void clear();
+
+    int getBlockCount() const;
+    int getLargestBlockSize() const;
+    const std::vector<int>& getArticulationCells() const;
+    bool isArticulation(const Point& p) const;
+    std::vector<Point> getChokepoints() const;
+
+    bool getCorridor(const Point& start, const Point& goal, std::vector<bool>& allowed) const;
+    bool restrictSearch(const Point& start, const Point& goal, SolveOptions& options) const;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef CELLLAYOUT_H
+#define CELLLAYOUT_H
+
+#include <cstddef>
+
+
+// Maps (x, y) in a width x height grid to a storage index. Directions
+// follow Maze: 0 = north, 1 = east, 2 = south, 3 = west.
+class RowMajorLayout {
+private:
+    int width_;
+    int height_;
+
+public:
+    RowMajorLayout() : width_(0), height_(0) {}
+    RowMajorLayout(int width, int height) : width_(width), height_(height) {}
+
+    static const char* name() {
+        return "row-major";
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
+    }
+
+    int index(int x, int y) const {
+        return y * width_ + x;
+    }
+
+    int x(int index) const {
+        return index % width_;
+    }
+
+    int y(int index) const {
+        return index / width_;
+    }
+
+    int neighbor(int index, int direction) const {
+        return index + ((direction == 2) - (direction == 0)) * width_ + (direction == 1) - (direction == 3);
+    }
+};
+
+
+// Square tiles of 2^TileShift cells per side, stored tile after tile in
+// row-major tile order. Vertical moves stay inside a tile most of the
+// time instead of jumping a full grid row.
+template <int TileShift>
+class TiledLayout {
+private:
+    static const int kTile = 1 << TileShift;
+    static const int kMask = kTile - 1;
+    static const int kTileCells = kTile * kTile;
+
+    int tilesPerRow_;
+    int tileRows_;
+    int rowSpan_;
+
+public:
+    TiledLayout() : tilesPerRow_(0), tileRows_(0), rowSpan_(0) {}
+    TiledLayout(int width, int height)
+        : tilesPerRow_((width + kMask) >> TileShift),
+          tileRows_((height + kMask) >> TileShift),
+          rowSpan_(((width + kMask) >> TileShift) * kTileCells) {}
+
+    static const char* name() {
+        return "tiled";
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(rowSpan_) * static_cast<std::size_t>(tileRows_);
+    }
+
+    int index(int x, int y) const {
+        return (((y >> TileShift) * tilesPerRow_ + (x >> TileShift)) << (2 * TileShift)) |
+               ((y & kMask) << TileShift) | (x & kMask);
+    }
+
+    int x(int index) const {
+        return (((index >> (2 * TileShift)) % tilesPerRow_) << TileShift) | (index & kMask);
+    }
+
+    int y(int index) const {
+        return (((index >> (2 * TileShift)) / tilesPerRow_) << TileShift) | ((index >> TileShift) & kMask);
+    }
+
+    // Branch-free: crossing a tile edge only adds a correction term.
+    int neighbor(int index, int direction) const {
+        const int lx = index & kMask;
+        const int ly = (index >> TileShift) & kMask;
+        switch (direction) {
+            case 0:
+                return index - kTile + (ly == 0) * (kTileCells - rowSpan_);
+            case 1:
+                return index + 1 + (lx == kMask) * (kTileCells - kTile);
+            case 2:
+                return index + kTile + (ly == kMask) * (rowSpan_ - kTileCells);
+            default:
+                return index - 1 - (lx == 0) * (kTileCells - kTile);
+        }
+    }
+};
+
+
+#if defined(MAZE_LAYOUT_TILED)
+typedef TiledLayout<3> CellLayout;
+#else
+typedef RowMajorLayout CellLayout;
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef COOPERATIVEPLANNER_H
+#define COOPERATIVEPLANNER_H
+
+#include "FlowField.h"
+#include "Maze.h"
+#include "Point.h"
+#include "SolveOptions.h"
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+struct AgentTask {
+    Point start;
+    Point goal;
+};
+
+
+struct AgentPlan {
+    std::vector<Point> path;
+    int arrivalTime = -1;
+    int replans = 0;
+    int searchFailures = 0;
+    long long nodesExplored = 0;
+    long long totalReplanMicros = 0;
+    long long maxReplanMicros = 0;
+};
+
+
+class ReservationTable {
+private:
+    long long cellCount_;
+    std::unordered_set<long long> vertices_;
+    std::unordered_set<long long> edges_;
+
+    long long vertexKey(int cell, int time) const;
+    long long edgeKey(int from, int to, int time) const;
+
+public:
+    ReservationTable();
+
+    void reset(int cellCount);
+    void clear();
+
+    void reserveVertex(int cell, int time);
+    void releaseVertex(int cell, int time);
+    void reserveEdge(int from, int to, int time);
+
+    bool isVertexReserved(int cell, int time) const;
+    bool isMoveBlocked(int from, int to, int time) const;
+    std::size_t size() const;
+};
+
+
+class CooperativePlanner {
+private:
+    struct SearchNode {
+        int cell;
+        int offset;
+        double g;
+        int parent;
+    };
+
+    // Flow fields are per-cell arrays, so the cache is bounded in bytes and
+    // drops the least recently used goal; the list holds goal cells, most
+    // recent first. A budget below the active goals rebuilds every cycle.
+    struct CachedField {
+        FlowField field;
+        std::list<int>::iterator use;
+    };
+
+    const Maze* maze_;
+    int window_;
+    int replanInterval_;
+    int maxTimeSteps_;
+    int time_;
+    int cycle_;
+    SolveStatus status_;
+
+    std::vector<AgentTask> tasks_;
+    std::vector<AgentPlan> plans_;
+    std::vector<int> positions_;
+    std::vector<int> goals_;
+    std::vector<std::vector<int>> windowPaths_;
+    std::unordered_map<int, CachedField> heuristics_;
+    std::list<int> heuristicOrder_;
+    std::size_t heuristicMemory_;
+    long long heuristicBuilds_;
+    ReservationTable reservations_;
+
+    std::vector<SearchNode> nodes_;
+    std::unordered_map<long long, int> nodeIndex_;
+
+    int toCell(const Point& p) const;
+    Point toPoint(int cell) const;
+    std::size_t maxHeuristics() const;
+    const FlowField& heuristicFor(int goalCell);
+    bool planWindow(int agent, const FlowField& field, SolveBudget& budget, bool& stopped);
+    void reservePath(const std::vector<int>& path);
+    bool allAtGoal() const;
+
+public:
+    CooperativePlanner();
+
+    void setWindow(int window);
+    void setReplanInterval(int steps);
+    void setMaxTimeSteps(int steps);
+    void setHeuristicMemory(std::size_t bytes);
+    int getWindow() const;
+    int getReplanInterval() const;
+    int getMaxTimeSteps() const;
+    std::size_t getHeuristicMemory() const;
+    long long getHeuristicBuilds() const;
+
+    bool begin(const Maze& maze, const std::vector<AgentTask>& tasks);
+    bool planCycle(const SolveOptions& options = SolveOptions());
+    SolveStatus solve(const Maze& maze, const std::vector<AgentTask>& tasks,
+                      const SolveOptions& options = SolveOptions());
+    bool isComplete() const;
+    SolveStatus getStatus() const;
+
+    int getTime() const;
+    const std::vector<AgentPlan>& getPlans() const;
+    int countConflicts() const;
+};
+
+#endif
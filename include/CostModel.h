@@ -0,0 +1,42 @@
+#ifndef COSTMODEL_H
+#define COSTMODEL_H
+
+#include <limits>
+#include <memory>
+
+
+class CostModel {
+private:
+    double costs_[256];
+    double minimumCost_;
+
+    void updateMinimumCost();
+
+public:
+    CostModel();
+
+    static std::shared_ptr<const CostModel> standard();
+    static double impassable() {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double getCost(char cell) const {
+        return costs_[static_cast<unsigned char>(cell)];
+    }
+
+    bool isPassable(char cell) const {
+        return costs_[static_cast<unsigned char>(cell)] != impassable();
+    }
+
+    const double* getTable() const;
+    double getMinimumCost() const;
+    double getMaximumCost() const;
+    bool hasIntegerCosts() const;
+
+    bool setCost(char cell, double cost);
+    void setImpassable(char cell);
+
+    bool loadFromFile(const char* filename);
+};
+
+#endif
@@ -56,7 +56,7 @@ private:
 public:
     DijkstraSolver();
 
-    Path solve(const Maze& maze) override;
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
     int getNodesExplored() const override;
     std::string name() const override;
 };
@@ -0,0 +1,50 @@
+#ifndef EXTERNALBFS_H
+#define EXTERNALBFS_H
+
+#include "CostModel.h"
+#include "Path.h"
+#include "SolveOptions.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+
+struct ExternalBFSStats {
+    long long pathLength = -1;
+    int levels = 0;
+    long long cellsVisited = 0;
+    long long largestLevel = 0;
+    long long bytesRead = 0;
+    long long bytesWritten = 0;
+    int runFiles = 0;
+};
+
+
+class ExternalBFS {
+private:
+    std::string tempDirectory_;
+    std::size_t memoryBudget_;
+    int bandRows_;
+    bool recordPath_;
+    std::shared_ptr<const CostModel> costModel_;
+    ExternalBFSStats stats_;
+
+    std::string makeTempPath() const;
+
+public:
+    ExternalBFS();
+
+    void setTempDirectory(const std::string& directory);
+    void setMemoryBudget(std::size_t entries);
+    void setBandRows(int rows);
+    void setRecordPath(bool record);
+    void setCostModel(const std::shared_ptr<const CostModel>& model);
+
+    SolveResult solveFile(const char* filename, const SolveOptions& options = SolveOptions());
+
+    const CostModel& getCostModel() const;
+    const ExternalBFSStats& getStats() const;
+    long long getPathLength() const;
+};
+
+#endif
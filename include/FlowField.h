@@ -0,0 +1,46 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "Maze.h"
+#include "Point.h"
+#include <vector>
+
+
+class FlowField {
+private:
+    int width_;
+    int height_;
+    Point goal_;
+    bool built_;
+    std::vector<double> distance_;
+    std::vector<unsigned char> directions_;
+
+    int index(int x, int y) const;
+    bool inBounds(int x, int y) const;
+    int getDirectionAt(int cell) const;
+    void setDirectionAt(int cell, int direction);
+    bool pointsInto(int cell, int target) const;
+    void propagate(const Maze& maze, std::vector<int>& seeds);
+    void relaxFromNeighbors(const Maze& maze, int cell);
+    void collectDependents(int root, std::vector<int>& out) const;
+
+public:
+    FlowField();
+
+    void build(const Maze& maze);
+    void build(const Maze& maze, const Point& goal);
+    bool isBuilt() const;
+    Point getGoal() const;
+
+    void updateCell(const Maze& maze, const Point& p, char previous);
+    void setCell(Maze& maze, const Point& p, char value);
+
+    bool canReachGoal(const Point& p) const;
+    double getDistance(const Point& p) const;
+    int getDirection(const Point& p) const;
+    Point getNextStep(const Point& p) const;
+
+    int advanceAgents(std::vector<Point>& agents) const;
+};
+
+#endif
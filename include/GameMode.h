@@ -5,6 +5,7 @@
 #include "Point.h"
 #include "Renderer.h"
 #include "CLIUtils.h"
+#include "IncrementalSolver.h"
 #include <chrono>
 #include <string>
 #include <vector>
@@ -38,11 +39,19 @@ private:
     std::vector<std::pair<std::string, int>> statusLog_;
 
     
+    IncrementalAStar hintSearch_;
+    bool hintPending_;
+    std::vector<bool> hintCells_;
+
+    
     void initNcurses();
     void cleanupNcurses();
     void handleInput();
     void updateDisplay();
     bool isValidMove(const Point& newPos) const;
+    void requestHint();
+    void advanceHint();
+    void clearHint();
 
     
     void drawLayout();
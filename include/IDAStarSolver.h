@@ -0,0 +1,57 @@
+#ifndef IDASTARSOLVER_H
+#define IDASTARSOLVER_H
+
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+class IDAStarSolver : public MazeSolverStrategy {
+private:
+    struct Frame {
+        Point point;
+        double g;
+        int nextDirection;
+        bool expanded;
+    };
+
+    struct TableEntry {
+        double g;
+        int iteration;
+    };
+
+    std::size_t tableCapacity_;
+    std::unordered_map<int, TableEntry> table_;
+    std::unordered_set<int> onPath_;
+    std::vector<Frame> stack_;
+    int nodesExplored_;
+    int iterations_;
+    std::size_t peakBytes_;
+    double heuristicScale_;
+
+    int pointToIndex(const Point& p, int width) const;
+    double getCellCost(const Maze& maze, const Point& p) const;
+    double heuristic(const Point& p, const Point& goal) const;
+    bool isPrunedByTable(int index, double g, int iteration);
+    std::size_t currentBytes() const;
+    void releaseSearchState();
+    Path buildPath() const;
+
+public:
+    explicit IDAStarSolver(std::size_t tableCapacity = 65536);
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
+    int getNodesExplored() const override;
+    std::string name() const override;
+
+    void setTableCapacity(std::size_t capacity);
+    std::size_t getTableCapacity() const;
+    int getIterations() const;
+    std::size_t getPeakBytes() const;
+};
+
+#endif
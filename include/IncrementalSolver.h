@@ -0,0 +1,110 @@
+#ifndef INCREMENTALSOLVER_H
+#define INCREMENTALSOLVER_H
+
+#include "Maze.h"
+#include "Path.h"
+#include "Point.h"
+#include "SolveOptions.h"
+#include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// A search that can be advanced a bounded number of expansions at a time.
+// The open list, parents and distances survive between step() calls; the
+// maze passed to begin() must stay alive and unmodified until isDone().
+class IncrementalSolver {
+private:
+    const Maze* maze_;
+    SolveOptions options_;
+    std::unique_ptr<SolveBudget> budget_;
+    Point start_;
+    Point goal_;
+    int width_;
+    std::vector<int> parent_;
+    std::vector<double> distance_;
+    std::vector<bool> closed_;
+    int nodesExplored_;
+    bool done_;
+    SolveStatus status_;
+    Path path_;
+
+    void finish(SolveStatus status);
+    Path reconstructPath() const;
+
+protected:
+    int toIndex(const Point& p) const;
+    Point toPoint(int index) const;
+    const Maze& getMaze() const;
+    const Point& getGoal() const;
+
+    virtual void clearOpen() = 0;
+    virtual void pushOpen(int index, double g) = 0;
+    virtual bool popOpen(int& index) = 0;
+    virtual double stepCost(const Point& p) const = 0;
+
+public:
+    IncrementalSolver();
+    virtual ~IncrementalSolver() = default;
+
+    bool begin(const Maze& maze, const SolveOptions& options = SolveOptions());
+    bool begin(const Maze& maze, const Point& start, const Point& goal,
+               const SolveOptions& options = SolveOptions());
+
+    bool step(int maxNodes);
+    bool stepUntil(const SolveOptions::Clock::time_point& deadline, int chunkNodes = 256);
+
+    bool isDone() const;
+    SolveResult result() const;
+    int getNodesExplored() const;
+
+    virtual std::string name() const = 0;
+};
+
+
+class IncrementalBFS : public IncrementalSolver {
+private:
+    std::deque<int> open_;
+
+protected:
+    void clearOpen() override;
+    void pushOpen(int index, double g) override;
+    bool popOpen(int& index) override;
+    double stepCost(const Point& p) const override;
+
+public:
+    std::string name() const override;
+};
+
+
+class IncrementalDijkstra : public IncrementalSolver {
+private:
+    typedef std::pair<double, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_;
+
+protected:
+    virtual double heuristic(const Point& p) const;
+
+    void clearOpen() override;
+    void pushOpen(int index, double g) override;
+    bool popOpen(int& index) override;
+    double stepCost(const Point& p) const override;
+
+public:
+    std::string name() const override;
+};
+
+
+class IncrementalAStar : public IncrementalDijkstra {
+protected:
+    double heuristic(const Point& p) const override;
+
+public:
+    std::string name() const override;
+};
+
+#endif
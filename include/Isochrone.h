@@ -0,0 +1,58 @@
+#ifndef ISOCHRONE_H
+#define ISOCHRONE_H
+
+#include "Maze.h"
+#include "Point.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+class Isochrone {
+private:
+    int width_;
+    int height_;
+    Point origin_;
+    double budget_;
+    std::vector<int> cells_;
+    std::vector<double> costs_;
+
+    friend class IsochroneQuery;
+
+    int find(const Point& p) const;
+
+public:
+    Isochrone();
+
+    Point getOrigin() const;
+    double getBudget() const;
+    int getSize() const;
+
+    const std::vector<int>& getCells() const;
+    const std::vector<double>& getCosts() const;
+    Point getPointAt(int index) const;
+
+    bool contains(const Point& p) const;
+    double getCost(const Point& p) const;
+    void fillBitset(std::vector<std::uint64_t>& bits) const;
+};
+
+
+class IsochroneQuery {
+private:
+    std::vector<double> distance_;
+    std::vector<unsigned int> stamp_;
+    unsigned int generation_;
+    std::vector<std::pair<double, int>> heap_;
+    int nodesExplored_;
+
+    void prepare(int cells);
+
+public:
+    IsochroneQuery();
+
+    Isochrone compute(const Maze& maze, const Point& origin, double budget);
+    int getNodesExplored() const;
+};
+
+#endif
@@ -0,0 +1,311 @@
+#ifndef LOWMEMORYSOLVERS_H
+#define LOWMEMORYSOLVERS_H
+
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include "Point.h"
+#include "SolveOptions.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+
+// Grid is any type exposing getWidth(), getStart(), getGoal(),
+// isWalkable(const Point&) and getCellCost(const Point&): Maze for in-memory
+// grids, MappedMaze for files read in place.
+class GridWalk {
+public:
+    static Point step(const Point& p, int dir) {
+        static const int dx[4] = {0, 1, 0, -1};
+        static const int dy[4] = {-1, 0, 1, 0};
+        return Point(p.getX() + dx[dir], p.getY() + dy[dir]);
+    }
+
+    template <typename Grid>
+    static long long cellKey(const Grid& grid, const Point& p) {
+        return static_cast<long long>(p.getY()) * grid.getWidth() + p.getX();
+    }
+
+    template <typename Grid>
+    static Path toPath(const Grid& grid, const std::vector<Point>& points) {
+        Path path;
+        double cost = 0.0;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            path.addPoint(points[i]);
+            if (i > 0) cost += grid.getCellCost(points[i]);
+        }
+        path.setCost(cost);
+        return path;
+    }
+};
+
+
+// Left-hand rule. Memory is the current path only: stepping back onto a
+// cell already on it erases the loop, so on a tree the stack is exactly the
+// unique start-goal path. The walker first runs straight to a wall, then
+// follows it until it reaches the goal or leaves the anchor cell the same
+// way twice, at which point that wall has been fully traced.
+template <typename Grid>
+class WallFollowerSearch {
+public:
+    SolveResult run(const Grid& grid, const SolveOptions& options = SolveOptions()) {
+        steps_ = 0;
+        peakPathLength_ = 0;
+        path_.clear();
+        onPath_.clear();
+
+        // The left-hand rule is defined by the maze's own walls; treating
+        // masked cells as walls would trace a different maze.
+        if (options.hasAllowedCells()) {
+            return SolveResult(SolveStatus::Unsupported);
+        }
+
+        const Point start = grid.getStart();
+        const Point goal = grid.getGoal();
+        if (!grid.isWalkable(start) || !grid.isWalkable(goal)) {
+            return SolveResult(SolveStatus::Unreachable);
+        }
+
+        push(grid, start);
+        Point current = start;
+        int heading = 0;
+        while (current != goal && grid.isWalkable(GridWalk::step(current, heading))) {
+            current = GridWalk::step(current, heading);
+            moveTo(grid, current);
+        }
+
+        const Point anchor = current;
+        int firstHeading = -1;
+
+        SolveBudget budget(options);
+        while (current != goal) {
+            if (!budget.consume()) {
+                return SolveResult(budget.getStopStatus());
+            }
+            steps_++;
+
+            int next = -1;
+            for (int turn = 3; turn <= 6; turn++) {
+                int dir = (heading + turn) % 4;
+                if (grid.isWalkable(GridWalk::step(current, dir))) {
+                    next = dir;
+                    break;
+                }
+            }
+            if (next == -1) {
+                return SolveResult(SolveStatus::Unreachable);
+            }
+
+            if (current == anchor) {
+                if (firstHeading == next) {
+                    return SolveResult(SolveStatus::Unreachable);
+                }
+                if (firstHeading == -1) {
+                    firstHeading = next;
+                }
+            }
+
+            heading = next;
+            current = GridWalk::step(current, heading);
+            moveTo(grid, current);
+        }
+
+        Path path = GridWalk::toPath(grid, path_);
+        path_.clear();
+        onPath_.clear();
+        return SolveResult(SolveStatus::Found, path);
+    }
+
+    long long getSteps() const {
+        return steps_;
+    }
+
+    std::size_t getPeakPathLength() const {
+        return peakPathLength_;
+    }
+
+private:
+    std::vector<Point> path_;
+    std::unordered_set<long long> onPath_;
+    long long steps_ = 0;
+    std::size_t peakPathLength_ = 0;
+
+    void push(const Grid& grid, const Point& p) {
+        path_.push_back(p);
+        onPath_.insert(GridWalk::cellKey(grid, p));
+        if (path_.size() > peakPathLength_) peakPathLength_ = path_.size();
+    }
+
+    void moveTo(const Grid& grid, const Point& p) {
+        if (onPath_.count(GridWalk::cellKey(grid, p)) == 0) {
+            push(grid, p);
+            return;
+        }
+        while (path_.back() != p) {
+            onPath_.erase(GridWalk::cellKey(grid, path_.back()));
+            path_.pop_back();
+        }
+    }
+};
+
+
+// Trémaux's rule with passage marks kept in a hash map, so memory grows
+// with the passages walked rather than with W*H. Passages marked once form
+// the route from the start to the current cell.
+template <typename Grid>
+class TremauxSearch {
+public:
+    SolveResult run(const Grid& grid, const SolveOptions& options = SolveOptions()) {
+        steps_ = 0;
+        peakMarks_ = 0;
+        marks_.clear();
+
+        // Restricted searches need a W*H mask, which these walkers exist
+        // to avoid; they are left to the in-memory solvers.
+        if (options.hasAllowedCells()) {
+            return SolveResult(SolveStatus::Unsupported);
+        }
+
+        const Point start = grid.getStart();
+        const Point goal = grid.getGoal();
+        if (!grid.isWalkable(start) || !grid.isWalkable(goal)) {
+            return SolveResult(SolveStatus::Unreachable);
+        }
+
+        Point current = start;
+        int entrance = -1;
+
+        SolveBudget budget(options);
+        while (current != goal) {
+            if (!budget.consume()) {
+                marks_.clear();
+                return SolveResult(budget.getStopStatus());
+            }
+            steps_++;
+
+            int counts[4];
+            bool visited = false;
+            for (int dir = 0; dir < 4; dir++) {
+                counts[dir] = grid.isWalkable(GridWalk::step(current, dir)) ? getMark(grid, current, dir) : -1;
+                if (dir != entrance && counts[dir] > 0) visited = true;
+            }
+
+            int choice = -1;
+            if (entrance >= 0 && visited && counts[entrance] == 1) {
+                choice = entrance;
+            } else {
+                for (int dir = 0; dir < 4; dir++) {
+                    if (counts[dir] < 0 || counts[dir] >= 2) continue;
+                    if (choice == -1 || counts[dir] < counts[choice] ||
+                        (counts[dir] == counts[choice] && choice == entrance)) {
+                        choice = dir;
+                    }
+                }
+            }
+            if (choice == -1) {
+                marks_.clear();
+                return SolveResult(SolveStatus::Unreachable);
+            }
+
+            addMark(grid, current, choice);
+            current = GridWalk::step(current, choice);
+            entrance = (choice + 2) % 4;
+        }
+
+        Path path = GridWalk::toPath(grid, singleMarkedRoute(grid, start, goal));
+        marks_.clear();
+        return SolveResult(SolveStatus::Found, path);
+    }
+
+    long long getSteps() const {
+        return steps_;
+    }
+
+    std::size_t getPeakMarks() const {
+        return peakMarks_;
+    }
+
+private:
+    std::unordered_map<long long, unsigned char> marks_;
+    long long steps_ = 0;
+    std::size_t peakMarks_ = 0;
+
+    // Each passage is keyed by the cell above or left of it plus its axis.
+    long long passageKey(const Grid& grid, const Point& p, int dir) const {
+        Point base = (dir == 0 || dir == 3) ? GridWalk::step(p, dir) : p;
+        return GridWalk::cellKey(grid, base) * 2 + (dir % 2 == 0 ? 1 : 0);
+    }
+
+    int getMark(const Grid& grid, const Point& p, int dir) const {
+        auto it = marks_.find(passageKey(grid, p, dir));
+        return it == marks_.end() ? 0 : it->second;
+    }
+
+    void addMark(const Grid& grid, const Point& p, int dir) {
+        marks_[passageKey(grid, p, dir)]++;
+        if (marks_.size() > peakMarks_) peakMarks_ = marks_.size();
+    }
+
+    std::vector<Point> singleMarkedRoute(const Grid& grid, const Point& start, const Point& goal) const {
+        std::vector<Point> route(1, start);
+        Point current = start;
+        int back = -1;
+        while (current != goal) {
+            int next = -1;
+            for (int dir = 0; dir < 4 && next == -1; dir++) {
+                if (dir != back && grid.isWalkable(GridWalk::step(current, dir)) && getMark(grid, current, dir) == 1) {
+                    next = dir;
+                }
+            }
+            current = GridWalk::step(current, next);
+            back = (next + 2) % 4;
+            route.push_back(current);
+        }
+        return route;
+    }
+};
+
+
+
+class WallFollowerSolver : public MazeSolverStrategy {
+public:
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override {
+        return search_.run(maze, options);
+    }
+
+    int getNodesExplored() const override {
+        return static_cast<int>(search_.getSteps());
+    }
+
+    std::string name() const override {
+        return "Wall Follower";
+    }
+
+private:
+    WallFollowerSearch<Maze> search_;
+};
+
+
+class TremauxSolver : public MazeSolverStrategy {
+public:
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override {
+        return search_.run(maze, options);
+    }
+
+    int getNodesExplored() const override {
+        return static_cast<int>(search_.getSteps());
+    }
+
+    std::string name() const override {
+        return "Tremaux";
+    }
+
+private:
+    TremauxSearch<Maze> search_;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef MAPPEDMAZE_H
+#define MAPPEDMAZE_H
+
+#include "CostModel.h"
+#include "Point.h"
+#include <cstddef>
+#include <memory>
+
+
+class MappedMaze {
+private:
+    const char* data_;
+    std::size_t size_;
+    std::size_t cellsOffset_;
+    std::size_t rowStride_;
+    std::size_t cellStride_;
+    int width_;
+    int height_;
+    Point start_;
+    Point goal_;
+    std::shared_ptr<const CostModel> costModel_;
+
+    bool parseLayout();
+    void findEndpoints();
+
+public:
+    MappedMaze();
+    ~MappedMaze();
+
+    MappedMaze(const MappedMaze&) = delete;
+    MappedMaze& operator=(const MappedMaze&) = delete;
+
+    bool open(const char* filename);
+    void close();
+    bool isOpen() const;
+
+    int getWidth() const;
+    int getHeight() const;
+    Point getStart() const;
+    Point getGoal() const;
+    char getCellAt(int x, int y) const;
+    char getCellAt(const Point& p) const;
+    const CostModel& getCostModel() const;
+    double getCellCost(const Point& p) const;
+
+    void setStart(const Point& p);
+    void setGoal(const Point& p);
+    void setCostModel(const std::shared_ptr<const CostModel>& model);
+
+    bool isValid(const Point& p) const;
+    bool isWalkable(const Point& p) const;
+};
+
+#endif
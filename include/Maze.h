@@ -1,28 +1,70 @@
 #ifndef MAZE_H
 #define MAZE_H
 
+#include "CellLayout.h"
+#include "CostModel.h"
 #include "Point.h"
+#include "ReachabilityIndex.h"
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <vector>
 
 
+enum class CellStorage {
+    Bytes,
+    Packed
+};
+
+
 class Maze {
 private:
     std::vector<char> grid_;    
     int width_;                 
     int height_;
+    CellLayout layout_;
     Point start_;               
     Point goal_;                
+    std::shared_ptr<const CostModel> costModel_;
+    mutable ReachabilityIndex reachability_;
+    // Changes whenever cells or the cost model change; caches built from
+    // the maze compare it to detect staleness.
+    std::uint64_t revision_;
+
+    // Packed backend: 2 or 4 bit palette codes. Every symbol, including
+    // 'S' and 'G', is stored exactly as the byte backend stores it.
+    CellStorage storage_;
+    std::vector<std::uint8_t> packed_;
+    int bitsPerCell_;
+    int packShift_;
+    int paletteSize_;
+    char palette_[16];
+    unsigned char paletteCodes_[256];
+
+    // Open-direction bits per cell (N=1, E=2, S=4, W=8), two cells per byte.
+    // Byte storage only: at 4 bits per cell the masks would outweigh packed
+    // cells, so packed mazes derive each mask from the four neighbours.
+    std::vector<std::uint8_t> openMasks_;
 
-    int index(int x, int y) const;
     char getCellUnchecked(int x, int y) const;
     void setCellUnchecked(int x, int y, char value);
 
+    void allocateCells(char fill);
+    void resetPalette();
+    int addToPalette(char symbol);
+    void writeCode(std::size_t cell, int code);
+    void repack(int bitsPerCell);
+
+    void rebuildOpenMasks();
+    void refreshOpenMasksAround(int x, int y);
+
 public:
     
     Maze();
     Maze(int width, int height);
+    Maze(int width, int height, CellStorage storage);
 
     
     Maze(const Maze&) = default;
@@ -38,12 +80,77 @@ public:
     Point getGoal() const;
     char getCellAt(const Point& p) const;
     char getCellAt(int x, int y) const;
+    const CostModel& getCostModel() const;
+    std::shared_ptr<const CostModel> getCostModelHandle() const;
+    double getCellCost(const Point& p) const;
+
+    
+    CellStorage getStorage() const;
+    bool setStorage(CellStorage storage);
+    int getBitsPerCell() const;
+    std::size_t getStorageBytes() const;
+    int getPaletteSize() const;
+    char getPaletteSymbol(int code) const;
+
+    int getPackedCode(int x, int y) const {
+        return getPackedCodeAtIndex(cellIndex(x, y));
+    }
+
+    int getPackedCodeAtIndex(int index) const {
+        std::size_t cell = static_cast<std::size_t>(index);
+        int slot = static_cast<int>(cell & ((static_cast<std::size_t>(1) << packShift_) - 1));
+        return (packed_[cell >> packShift_] >> (slot * bitsPerCell_)) & ((1 << bitsPerCell_) - 1);
+    }
+
+    
+    // Cells live in a (width + 2) x (height + 2) grid whose border is wall,
+    // so neighborIndex() from any maze cell never leaves the storage. The
+    // index order is fixed at compile time by CellLayout.
+    const CellLayout& getLayout() const {
+        return layout_;
+    }
+
+    std::size_t cellCount() const {
+        return layout_.size();
+    }
+
+    int cellIndex(int x, int y) const {
+        return layout_.index(x + 1, y + 1);
+    }
+
+    int cellIndex(const Point& p) const {
+        return cellIndex(p.getX(), p.getY());
+    }
+
+    Point cellPoint(int index) const {
+        return Point(layout_.x(index) - 1, layout_.y(index) - 1);
+    }
+
+    int neighborIndex(int index, int direction) const {
+        return layout_.neighbor(index, direction);
+    }
+
+    char getCellAtIndex(int index) const {
+        if (storage_ == CellStorage::Bytes) {
+            return grid_[static_cast<std::size_t>(index)];
+        }
+        return palette_[getPackedCodeAtIndex(index)];
+    }
+
+    bool isWalkableAtIndex(int index) const {
+        return costModel_->isPassable(getCellAtIndex(index));
+    }
+
+    double getCellCostAtIndex(int index) const {
+        return costModel_->getCost(getCellAtIndex(index));
+    }
 
     
     void setStart(const Point& p);
     void setGoal(const Point& p);
     void setCellAt(const Point& p, char value);
     void setCellAt(int x, int y, char value);
+    void setCostModel(const std::shared_ptr<const CostModel>& model);
 
     
     bool loadFromFile(const char* filename);
@@ -54,10 +161,62 @@ public:
     bool isWalkable(const Point& p) const;
     bool isStart(const Point& p) const;
     bool isGoal(const Point& p) const;
+    bool hasUniformCosts() const;
+    std::uint64_t getRevision() const;
+
+    
+    void buildReachabilityIndex() const;
+    bool hasReachabilityIndex() const;
+    bool areConnected(const Point& a, const Point& b) const;
 
     
     void getNeighbors(const Point& p, Point* neighbors, int& count) const;
 
+    int getOpenMask(int x, int y) const {
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+            return 0;
+        }
+        return getOpenMaskAtIndex(cellIndex(x, y));
+    }
+
+    int getOpenMaskAtIndex(int index) const {
+        if (storage_ == CellStorage::Packed) {
+            return static_cast<int>(isWalkableAtIndex(layout_.neighbor(index, 0))) |
+                   static_cast<int>(isWalkableAtIndex(layout_.neighbor(index, 1))) << 1 |
+                   static_cast<int>(isWalkableAtIndex(layout_.neighbor(index, 2))) << 2 |
+                   static_cast<int>(isWalkableAtIndex(layout_.neighbor(index, 3))) << 3;
+        }
+        std::size_t cell = static_cast<std::size_t>(index);
+        return (openMasks_[cell >> 1] >> ((cell & 1) << 2)) & 0xF;
+    }
+
+    int getOpenMask(const Point& p) const {
+        return getOpenMask(p.getX(), p.getY());
+    }
+
+    int getDegree(const Point& p) const {
+        int mask = getOpenMask(p);
+        return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+    }
+
+    static int directionDx(int direction) {
+        return (direction == 1) - (direction == 3);
+    }
+
+    static int directionDy(int direction) {
+        return (direction == 2) - (direction == 0);
+    }
+
+    template <typename Visitor>
+    void forEachNeighbor(const Point& p, Visitor visit) const {
+        int mask = getOpenMask(p);
+        while (mask != 0) {
+            int direction = (mask & 1) ? 0 : (mask & 2) ? 1 : (mask & 4) ? 2 : 3;
+            mask &= mask - 1;
+            visit(Point(p.getX() + directionDx(direction), p.getY() + directionDy(direction)));
+        }
+    }
+
     
     void display() const;
 };
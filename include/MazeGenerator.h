@@ -1,8 +1,10 @@
 #ifndef MAZEGENERATOR_H
 #define MAZEGENERATOR_H
 
+#include "CostModel.h"
 #include "Maze.h"
 #include "Point.h"
+#include <memory>
 #include <vector>
 
 
@@ -12,6 +14,7 @@ private:
     int height_;
     int seed_;
     std::vector<bool> visited_;
+    std::shared_ptr<const CostModel> costModel_;
 
     
     void initializeVisited(const Maze& maze);
@@ -43,6 +46,7 @@ public:
     
     void setSeed(int seed);
     void setDimensions(int width, int height);
+    void setCostModel(const std::shared_ptr<const CostModel>& model);
 };
 
 #endif
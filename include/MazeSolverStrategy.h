@@ -3,6 +3,7 @@
 
 #include "Maze.h"
 #include "Path.h"
+#include "SolveOptions.h"
 #include <string>
 
 
@@ -10,9 +11,13 @@ class MazeSolverStrategy {
 public:
     virtual ~MazeSolverStrategy() = default;
 
-    virtual Path solve(const Maze& maze) = 0;
+    virtual SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) = 0;
     virtual int getNodesExplored() const = 0;
     virtual std::string name() const = 0;
+
+    Path solve(const Maze& maze) {
+        return solveWithOptions(maze, SolveOptions()).getPath();
+    }
 };
 
 #endif
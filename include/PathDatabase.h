@@ -0,0 +1,54 @@
+#ifndef PATHDATABASE_H
+#define PATHDATABASE_H
+
+#include "Maze.h"
+#include "Path.h"
+#include "Point.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+struct PathDatabaseStats {
+    long long buildMillis = 0;
+    int threads = 0;
+    int nodes = 0;
+    long long runs = 0;
+    std::size_t compressedBytes = 0;
+    std::size_t uncompressedBytes = 0;
+};
+
+
+class PathDatabase {
+private:
+    int width_;
+    int height_;
+    std::vector<int> cellToNode_;
+    std::vector<int> nodeToCell_;
+    std::vector<int> component_;
+    std::vector<double> nodeCost_;
+    std::vector<std::uint32_t> rowOffsets_;
+    std::vector<std::uint32_t> runs_;
+    PathDatabaseStats stats_;
+
+    int nodeAt(const Point& p) const;
+    void orderNodes(const Maze& maze);
+    void updateSizeStats();
+
+public:
+    PathDatabase();
+
+    bool build(const Maze& maze, int threads = 0);
+    bool isBuilt() const;
+    void clear();
+
+    bool saveToFile(const char* filename) const;
+    bool loadFromFile(const char* filename);
+
+    int getFirstMove(const Point& from, const Point& to) const;
+    Path getPath(const Point& from, const Point& to) const;
+
+    const PathDatabaseStats& getStats() const;
+};
+
+#endif
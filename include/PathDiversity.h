@@ -0,0 +1,73 @@
+#ifndef PATHDIVERSITY_H
+#define PATHDIVERSITY_H
+
+#include "Maze.h"
+#include "Point.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+enum class PathCountMode {
+    Saturating,
+    Modular
+};
+
+
+class PathDiversity {
+private:
+    bool reachable_;
+    double shortestCost_;
+    std::uint64_t pathCount_;
+    bool saturated_;
+    int cellsOnShortestPaths_;
+    int mandatoryCells_;
+    int decisionCells_;
+    int width_;
+    std::vector<bool> onShortestPath_;
+
+    friend class PathDiversityAnalyzer;
+
+public:
+    PathDiversity();
+
+    bool isReachable() const;
+    double getShortestCost() const;
+    std::uint64_t getPathCount() const;
+    bool isSaturated() const;
+    int getCellsOnShortestPaths() const;
+    int getMandatoryCells() const;
+    int getDecisionCells() const;
+    bool isOnShortestPath(const Point& p) const;
+
+    void display() const;
+    friend std::ostream& operator<<(std::ostream& os, const PathDiversity& d);
+};
+
+
+class PathDiversityAnalyzer {
+private:
+    struct Sweep {
+        std::vector<double> distance;
+        std::vector<std::uint64_t> count;
+        bool saturated = false;
+    };
+
+    PathCountMode mode_;
+    bool parallel_;
+
+    void sweep(const Maze& maze, const Point& source, bool forward, bool uniform, Sweep& out) const;
+    std::uint64_t add(std::uint64_t a, std::uint64_t b, bool& saturated) const;
+
+public:
+    PathDiversityAnalyzer();
+
+    void setMode(PathCountMode mode);
+    void setParallel(bool parallel);
+    PathCountMode getMode() const;
+    bool isParallel() const;
+
+    PathDiversity analyze(const Maze& maze) const;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef PERFECTMAZEINDEX_H
+#define PERFECTMAZEINDEX_H
+
+#include "DijkstraSolver.h"
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include "Point.h"
+#include "SolveOptions.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class PerfectMazeIndex {
+private:
+    int width_;
+    int height_;
+    int nodeCount_;
+    bool built_;
+
+    std::vector<int> nodeOfCell_;
+    std::vector<int> cellOfNode_;
+    std::vector<int> parent_;
+    std::vector<int> depth_;
+    std::vector<double> costDepth_;
+    std::vector<double> cellCost_;
+    std::vector<int> component_;
+    std::vector<int> preorder_;
+    std::vector<int> position_;
+    std::vector<int> sparse_;
+    std::vector<int> log2_;
+
+    int nodeAt(const Point& p) const;
+    Point pointOf(int node) const;
+    int shallower(int a, int b) const;
+    int lowestCommonAncestor(int a, int b) const;
+    bool buildSparseTable(SolveBudget* budget);
+
+public:
+    PerfectMazeIndex();
+
+    static bool isTree(const Maze& maze);
+
+    // False if the maze has a loop, or if the budget stopped the build; the
+    // budget's stop status tells the two apart.
+    bool build(const Maze& maze, SolveBudget* budget = nullptr);
+    bool isBuilt() const;
+    void clear();
+
+    bool connected(const Point& a, const Point& b) const;
+    int getDistance(const Point& a, const Point& b) const;
+    double getCost(const Point& a, const Point& b) const;
+    Point getMeetingPoint(const Point& a, const Point& b) const;
+    Path getPath(const Point& a, const Point& b) const;
+};
+
+
+// Builds the index once per maze revision and answers later solves on the
+// same maze from it. Mazes with loops are remembered too and go straight
+// to Dijkstra.
+class TreeIndexSolver : public MazeSolverStrategy {
+private:
+    PerfectMazeIndex index_;
+    DijkstraSolver fallback_;
+    std::uint64_t revision_;
+    bool cached_;
+    int nodesExplored_;
+    bool usedFallback_;
+
+public:
+    TreeIndexSolver();
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
+    int getNodesExplored() const override;
+    std::string name() const override;
+
+    bool usedFallback() const;
+};
+
+#endif
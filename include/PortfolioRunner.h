@@ -0,0 +1,79 @@
+#ifndef PORTFOLIORUNNER_H
+#define PORTFOLIORUNNER_H
+
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "SolveOptions.h"
+#include "SolverPlanner.h"
+#include "SolverPool.h"
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+enum class PortfolioMode {
+    FirstResult,
+    AllResults
+};
+
+
+struct PortfolioEntry {
+    std::string name;
+    SolveResult result;
+    int nodesExplored = 0;
+    double elapsedMillis = 0.0;
+    bool finished = false;
+};
+
+
+class PortfolioResult {
+private:
+    std::vector<PortfolioEntry> entries_;
+    int winner_;
+    double wallMillis_;
+
+    friend class PortfolioRunner;
+
+public:
+    PortfolioResult();
+
+    bool hasWinner() const;
+    const PortfolioEntry& getWinner() const;
+    int getWinnerIndex() const;
+    const std::vector<PortfolioEntry>& getEntries() const;
+    double getWallMillis() const;
+
+    void display() const;
+    friend std::ostream& operator<<(std::ostream& os, const PortfolioResult& result);
+};
+
+
+class PortfolioRunner {
+public:
+    typedef std::function<std::unique_ptr<MazeSolverStrategy>()> Factory;
+
+private:
+    SolverPool& pool_;
+    PortfolioMode mode_;
+    std::vector<Factory> factories_;
+
+public:
+    explicit PortfolioRunner(SolverPool& pool = SolverPool::shared());
+
+    void setMode(PortfolioMode mode);
+    PortfolioMode getMode() const;
+
+    void addStrategy(const Factory& factory);
+    void addEngine(SolverEngine engine);
+    void addEngines(const std::vector<SolverEngine>& engines);
+    void clear();
+    int getStrategyCount() const;
+
+    PortfolioResult run(const std::shared_ptr<const Maze>& snapshot,
+                        const SolveOptions& options = SolveOptions()) const;
+    PortfolioResult run(const Maze& maze, const SolveOptions& options = SolveOptions()) const;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef REACHABILITYINDEX_H
+#define REACHABILITYINDEX_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+class Maze;
+
+
+class ReachabilityIndex {
+private:
+    std::vector<int> parent_;
+    std::vector<int> componentSize_;
+    int width_;
+    int height_;
+    std::atomic<bool> built_;
+    mutable std::mutex buildMutex_;
+
+    int index(int x, int y) const;
+    int findRoot(int cell) const;
+    int findAndCompress(int cell);
+    void unite(int a, int b);
+    void flatten();
+
+public:
+    ReachabilityIndex();
+    ReachabilityIndex(const ReachabilityIndex& other);
+    ReachabilityIndex(ReachabilityIndex&& other) noexcept;
+    ReachabilityIndex& operator=(const ReachabilityIndex& other);
+    ReachabilityIndex& operator=(ReachabilityIndex&& other) noexcept;
+
+    void build(const Maze& maze);
+    // Safe to call from several threads sharing one const Maze.
+    void ensureBuilt(const Maze& maze);
+    void invalidate();
+    bool isBuilt() const;
+
+    void openCell(const Maze& maze, int x, int y);
+
+    int getComponent(int x, int y) const;
+    bool connected(int x1, int y1, int x2, int y2) const;
+};
+
+#endif
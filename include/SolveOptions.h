@@ -0,0 +1,130 @@
+#ifndef SOLVE_OPTIONS_H
+#define SOLVE_OPTIONS_H
+
+#include "Path.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+enum class SolveStatus {
+    Found,
+    Unreachable,
+    BudgetExceeded,
+    Cancelled,
+    Unsupported
+};
+
+std::string solveStatusName(SolveStatus status);
+
+
+class CancellationToken {
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+
+public:
+    CancellationToken();
+
+    void cancel();
+    bool isCancelled() const;
+};
+
+
+// The allowed-cells mask holds one flag per maze cell, indexed
+// y * maze.getWidth() + x with no sentinel border, whatever CellLayout the
+// maze stores its grid in; padded Maze::cellIndex() values must be
+// converted first. The start cell is always allowed. A solver that cannot
+// keep its search inside the mask returns SolveStatus::Unsupported instead
+// of ignoring it.
+class SolveOptions {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    bool hasDeadline_;
+    Clock::time_point deadline_;
+    long long maxNodes_;
+    bool hasCancellation_;
+    CancellationToken cancellation_;
+    std::shared_ptr<const std::vector<bool>> allowedCells_;
+
+public:
+    SolveOptions();
+
+    void setDeadline(const Clock::time_point& deadline);
+    void setTimeBudget(const std::chrono::milliseconds& budget);
+    void setMaxNodes(long long maxNodes);
+    void setCancellationToken(const CancellationToken& token);
+    void setAllowedCells(const std::shared_ptr<const std::vector<bool>>& mask);
+    void clearLimits();
+
+    bool hasDeadline() const;
+    Clock::time_point getDeadline() const;
+    long long getMaxNodes() const;
+    bool hasCancellationToken() const;
+    const CancellationToken& getCancellationToken() const;
+    bool hasAllowedCells() const;
+
+    bool isCellAllowed(int index) const {
+        return !allowedCells_ || (*allowedCells_)[static_cast<std::size_t>(index)];
+    }
+};
+
+
+class SolveResult {
+private:
+    SolveStatus status_;
+    Path path_;
+
+public:
+    SolveResult();
+    explicit SolveResult(SolveStatus status);
+    SolveResult(SolveStatus status, const Path& path);
+
+    SolveStatus getStatus() const;
+    const Path& getPath() const;
+    bool isFound() const;
+};
+
+
+class SolveBudget {
+private:
+    static const int kCheckInterval = 256;
+
+    const SolveOptions& options_;
+    long long nodes_;
+    int untilCheck_;
+    SolveStatus stopStatus_;
+
+    bool checkSlowLimits();
+
+public:
+    explicit SolveBudget(const SolveOptions& options);
+
+    bool consume() {
+        ++nodes_;
+        if (options_.getMaxNodes() >= 0 && nodes_ > options_.getMaxNodes()) {
+            stopStatus_ = SolveStatus::BudgetExceeded;
+            return false;
+        }
+        if (--untilCheck_ > 0) {
+            return true;
+        }
+        untilCheck_ = kCheckInterval;
+        return checkSlowLimits();
+    }
+
+    // Checks the token and deadline right away, for callers that run in
+    // slices and must notice a stop between them.
+    bool poll() {
+        untilCheck_ = kCheckInterval;
+        return checkSlowLimits();
+    }
+
+    long long getNodesConsumed() const;
+    SolveStatus getStopStatus() const;
+};
+
+#endif
@@ -0,0 +1,447 @@
+#ifndef SOLVERKERNELS_H
+#define SOLVERKERNELS_H
+
+#include "CellLayout.h"
+#include "CostModel.h"
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include "SolveOptions.h"
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+
+class UniformCost {
+public:
+    typedef int Value;
+
+    static Value infinity() {
+        return std::numeric_limits<int>::max() / 2;
+    }
+
+    void attach(const Maze& maze) {
+        table_ = maze.getCostModel().getTable();
+    }
+
+    Value cost(char cell) const {
+        return table_[static_cast<unsigned char>(cell)] == CostModel::impassable() ? infinity() : 1;
+    }
+
+private:
+    const double* table_ = nullptr;
+};
+
+
+class TerrainCost {
+public:
+    typedef double Value;
+
+    static Value infinity() {
+        return CostModel::impassable();
+    }
+
+    void attach(const Maze& maze) {
+        table_ = maze.getCostModel().getTable();
+    }
+
+    Value cost(char cell) const {
+        return table_[static_cast<unsigned char>(cell)];
+    }
+
+private:
+    const double* table_ = nullptr;
+};
+
+
+class IntegerTerrainCost {
+public:
+    typedef int Value;
+
+    static Value infinity() {
+        return std::numeric_limits<int>::max() / 2;
+    }
+
+    void attach(const Maze& maze) {
+        const double* source = maze.getCostModel().getTable();
+        for (int i = 0; i < 256; i++) {
+            table_[i] = source[i] == CostModel::impassable() ? infinity() : static_cast<int>(source[i] + 0.5);
+        }
+    }
+
+    Value cost(char cell) const {
+        return table_[static_cast<unsigned char>(cell)];
+    }
+
+private:
+    Value table_[256];
+};
+
+
+template <typename Function>
+class FunctorCost {
+public:
+    typedef double Value;
+
+    explicit FunctorCost(Function function = Function()) : function_(function) {}
+
+    static Value infinity() {
+        return CostModel::impassable();
+    }
+
+    void attach(const Maze& maze) {
+        table_ = maze.getCostModel().getTable();
+    }
+
+    Value cost(char cell) const {
+        return table_[static_cast<unsigned char>(cell)] == CostModel::impassable() ? infinity() : function_(cell);
+    }
+
+private:
+    Function function_;
+    const double* table_ = nullptr;
+};
+
+
+
+template <typename Key>
+class FifoFrontier {
+public:
+    typedef Key KeyType;
+
+    void push(int index, Key key) {
+        items_.push_back(std::make_pair(key, index));
+    }
+
+    std::pair<Key, int> pop() {
+        return items_[head_++];
+    }
+
+    bool isEmpty() const {
+        return head_ == items_.size();
+    }
+
+    void clear() {
+        items_.clear();
+        head_ = 0;
+    }
+
+private:
+    std::vector<std::pair<Key, int>> items_;
+    std::size_t head_ = 0;
+};
+
+
+template <typename Key>
+class HeapFrontier {
+public:
+    typedef Key KeyType;
+
+    void push(int index, Key key) {
+        heap_.push(std::make_pair(key, index));
+    }
+
+    std::pair<Key, int> pop() {
+        std::pair<Key, int> top = heap_.top();
+        heap_.pop();
+        return top;
+    }
+
+    bool isEmpty() const {
+        return heap_.empty();
+    }
+
+    void clear() {
+        heap_ = Queue();
+    }
+
+private:
+    typedef std::priority_queue<std::pair<Key, int>, std::vector<std::pair<Key, int>>,
+                                std::greater<std::pair<Key, int>>> Queue;
+    Queue heap_;
+};
+
+
+// Dial's algorithm: a ring of buckets indexed by integer distance. Only
+// valid for small non-negative integer edge costs.
+template <typename Key>
+class BucketFrontier {
+    static_assert(std::is_integral<Key>::value, "BucketFrontier requires integral keys");
+
+public:
+    typedef Key KeyType;
+
+    explicit BucketFrontier(std::size_t maxEdgeCost = 8)
+        : buckets_(maxEdgeCost + 1), current_(0), size_(0) {}
+
+    void push(int index, Key key) {
+        buckets_[static_cast<std::size_t>(key) % buckets_.size()].push_back(index);
+        size_++;
+    }
+
+    std::pair<Key, int> pop() {
+        while (buckets_[static_cast<std::size_t>(current_) % buckets_.size()].empty()) {
+            current_++;
+        }
+        std::vector<int>& bucket = buckets_[static_cast<std::size_t>(current_) % buckets_.size()];
+        int index = bucket.back();
+        bucket.pop_back();
+        size_--;
+        return std::make_pair(current_, index);
+    }
+
+    bool isEmpty() const {
+        return size_ == 0;
+    }
+
+    void clear() {
+        for (auto& bucket : buckets_) bucket.clear();
+        current_ = 0;
+        size_ = 0;
+    }
+
+private:
+    std::vector<std::vector<int>> buckets_;
+    Key current_;
+    std::size_t size_;
+};
+
+
+
+class StopAtGoal {
+public:
+    static bool shouldStop(int index, int goal) {
+        return index == goal;
+    }
+};
+
+
+class ExhaustiveSearch {
+public:
+    static bool shouldStop(int, int) {
+        return false;
+    }
+};
+
+
+
+// State arrays follow Layout, which defaults to the maze's own CellLayout;
+// other layouts translate cell indices once in prepare().
+template <typename CostPolicy, typename Frontier, typename ExitPolicy, typename Layout = CellLayout>
+class SearchKernel {
+public:
+    typedef typename CostPolicy::Value Value;
+
+    static_assert(std::is_same<Value, typename Frontier::KeyType>::value,
+                  "Frontier key type must match the cost model value type");
+
+    explicit SearchKernel(const CostPolicy& model = CostPolicy(), const Frontier& frontier = Frontier())
+        : model_(model), frontier_(frontier), layout_(), width_(0), height_(0), nodesExplored_(0) {}
+
+    SolveResult run(const Maze& maze, const SolveOptions& options) {
+        nodesExplored_ = 0;
+        width_ = maze.getWidth();
+        height_ = maze.getHeight();
+        layout_ = Layout(width_ + 2, height_ + 2);
+
+        Point start = maze.getStart();
+        Point goal = maze.getGoal();
+        if (!maze.areConnected(start, goal)) {
+            return SolveResult(SolveStatus::Unreachable);
+        }
+
+        prepare(maze, options);
+
+        const int startIdx = toIndex(start);
+        const int goalIdx = toIndex(goal);
+        const Value* cost = cost_.data();
+        Value* dist = dist_.data();
+        int* parent = parent_.data();
+
+        SolveBudget budget(options);
+        frontier_.clear();
+        dist[startIdx] = Value();
+        frontier_.push(startIdx, Value());
+
+        bool found = false;
+        while (!frontier_.isEmpty()) {
+            std::pair<Value, int> top = frontier_.pop();
+            const int current = top.second;
+            const Value d = top.first;
+            if (d > dist[current]) continue;
+
+            if (!budget.consume()) {
+                return SolveResult(budget.getStopStatus());
+            }
+            nodesExplored_++;
+
+            if (ExitPolicy::shouldStop(current, goalIdx)) {
+                found = true;
+                break;
+            }
+
+            // Walls and the sentinel border carry an infinite cost, so the
+            // relaxation needs no bounds or walkability checks.
+            for (int k = 0; k < 4; k++) {
+                const int next = layout_.neighbor(current, k);
+                const Value candidate = d + cost[next];
+                if (candidate < dist[next]) {
+                    dist[next] = candidate;
+                    parent[next] = current;
+                    frontier_.push(next, candidate);
+                }
+            }
+        }
+
+        if (!found && dist[goalIdx] >= CostPolicy::infinity()) {
+            return SolveResult(SolveStatus::Unreachable);
+        }
+        return SolveResult(SolveStatus::Found, reconstruct(startIdx, goalIdx));
+    }
+
+    int getNodesExplored() const {
+        return nodesExplored_;
+    }
+
+    Value distanceAt(const Point& p) const {
+        return dist_[static_cast<std::size_t>(toIndex(p))];
+    }
+
+private:
+    CostPolicy model_;
+    Frontier frontier_;
+    std::vector<Value> cost_;
+    std::vector<Value> dist_;
+    std::vector<int> parent_;
+    Layout layout_;
+    int width_;
+    int height_;
+    int nodesExplored_;
+
+    int toIndex(const Point& p) const {
+        return layout_.index(p.getX() + 1, p.getY() + 1);
+    }
+
+    Point toPoint(int index) const {
+        return Point(layout_.x(index) - 1, layout_.y(index) - 1);
+    }
+
+    // Cells outside an allowed-cells mask get the wall cost, so restricted
+    // searches run the same loop.
+    void prepare(const Maze& maze, const SolveOptions& options) {
+        model_.attach(maze);
+        const bool restricted = options.hasAllowedCells();
+
+        std::size_t padded = layout_.size();
+        cost_.assign(padded, CostPolicy::infinity());
+        dist_.assign(padded, CostPolicy::infinity());
+        parent_.assign(padded, -1);
+
+        for (int y = 0; y < height_; y++) {
+            for (int x = 0; x < width_; x++) {
+                if (restricted && !options.isCellAllowed(y * width_ + x)) continue;
+                const int index = layout_.index(x + 1, y + 1);
+                cost_[static_cast<std::size_t>(index)] = model_.cost(maze.getCellAtIndex(maze.cellIndex(x, y)));
+            }
+        }
+    }
+
+    Path reconstruct(int startIdx, int goalIdx) const {
+        std::vector<Point> reverse;
+        for (int current = goalIdx; current != -1; current = parent_[static_cast<std::size_t>(current)]) {
+            reverse.push_back(toPoint(current));
+            if (current == startIdx) break;
+        }
+
+        Path path;
+        for (auto it = reverse.rbegin(); it != reverse.rend(); ++it) {
+            path.addPoint(*it);
+        }
+        path.setCost(static_cast<double>(dist_[static_cast<std::size_t>(goalIdx)]));
+        return path;
+    }
+};
+
+
+
+template <typename CostPolicy, typename Frontier, typename ExitPolicy = StopAtGoal, typename Layout = CellLayout>
+class KernelSolver : public MazeSolverStrategy {
+public:
+    explicit KernelSolver(const CostPolicy& model = CostPolicy(), const Frontier& frontier = Frontier())
+        : kernel_(model, frontier) {}
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override {
+        return kernel_.run(maze, options);
+    }
+
+    int getNodesExplored() const override {
+        return kernel_.getNodesExplored();
+    }
+
+protected:
+    SearchKernel<CostPolicy, Frontier, ExitPolicy, Layout> kernel_;
+};
+
+
+class FastBFSSolver : public KernelSolver<UniformCost, FifoFrontier<int>> {
+public:
+    std::string name() const override {
+        return "Breadth-First Search (Kernel)";
+    }
+};
+
+
+class FastDijkstraSolver : public KernelSolver<TerrainCost, HeapFrontier<double>> {
+public:
+    std::string name() const override {
+        return "Dijkstra's Algorithm (Kernel)";
+    }
+};
+
+
+// The bucket ring only holds integer costs up to maxEdgeCost; any other
+// cost model is solved with the heap kernel instead of being rounded.
+class BucketDijkstraSolver : public KernelSolver<IntegerTerrainCost, BucketFrontier<int>> {
+public:
+    explicit BucketDijkstraSolver(int maxEdgeCost = 8)
+        : KernelSolver<IntegerTerrainCost, BucketFrontier<int>>(
+              IntegerTerrainCost(), BucketFrontier<int>(static_cast<std::size_t>(maxEdgeCost))),
+          maxEdgeCost_(maxEdgeCost), fallback_(), usedFallback_(false) {}
+
+    bool supports(const CostModel& model) const {
+        return model.hasIntegerCosts() && model.getMaximumCost() <= static_cast<double>(maxEdgeCost_);
+    }
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override {
+        usedFallback_ = !supports(maze.getCostModel());
+        if (usedFallback_) {
+            return fallback_.solveWithOptions(maze, options);
+        }
+        return kernel_.run(maze, options);
+    }
+
+    int getNodesExplored() const override {
+        return usedFallback_ ? fallback_.getNodesExplored() : kernel_.getNodesExplored();
+    }
+
+    bool usedFallback() const {
+        return usedFallback_;
+    }
+
+    std::string name() const override {
+        return "Bucket Dijkstra (Kernel)";
+    }
+
+private:
+    int maxEdgeCost_;
+    FastDijkstraSolver fallback_;
+    bool usedFallback_;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SOLVERPLANNER_H
+#define SOLVERPLANNER_H
+
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+enum class SolverEngine {
+    TreeIndex,
+    BreadthFirst,
+    BucketDijkstra,
+    Dijkstra,
+    AStar
+};
+
+std::string solverEngineName(SolverEngine engine);
+std::unique_ptr<MazeSolverStrategy> createSolver(SolverEngine engine);
+
+
+struct MazeProfile {
+    int width = 0;
+    int height = 0;
+    long long openCells = 0;
+    long long edges = 0;
+    int components = 0;
+    long long loops = 0;
+    long long terrainCounts[256] = {};
+    bool connected = false;
+    bool uniformCosts = true;
+    bool integerCosts = true;
+    double minimumCost = 0.0;
+    double maximumCost = 0.0;
+    double meanCost = 0.0;
+    int manhattanDistance = 0;
+
+    double getLoopDensity() const;
+    double getCostRatio() const;
+};
+
+
+class SolverPlan {
+private:
+    MazeProfile profile_;
+    std::vector<SolverEngine> candidates_;
+    std::vector<std::string> reasons_;
+
+    friend class SolverPlanner;
+
+public:
+    SolverPlan();
+
+    const MazeProfile& getProfile() const;
+    SolverEngine getEngine() const;
+    const std::vector<SolverEngine>& getCandidates() const;
+    const std::vector<std::string>& getReasons() const;
+
+    std::unique_ptr<MazeSolverStrategy> createStrategy() const;
+
+    void display() const;
+    friend std::ostream& operator<<(std::ostream& os, const SolverPlan& plan);
+};
+
+
+class SolverPlanner {
+private:
+    double minLoopDensity_;
+    double minCostRatio_;
+    int maxBucketCost_;
+
+public:
+    SolverPlanner();
+
+    void setMinLoopDensity(double density);
+    void setMinCostRatio(double ratio);
+    void setMaxBucketCost(int cost);
+
+    MazeProfile profile(const Maze& maze) const;
+    SolverPlan plan(const Maze& maze) const;
+};
+
+#endif
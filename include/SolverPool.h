@@ -0,0 +1,78 @@
+#ifndef SOLVERPOOL_H
+#define SOLVERPOOL_H
+
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "SolveOptions.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+struct SolveJob;
+
+
+class SolveHandle {
+private:
+    std::shared_ptr<SolveJob> job_;
+
+    friend class SolverPool;
+    explicit SolveHandle(const std::shared_ptr<SolveJob>& job);
+
+public:
+    SolveHandle();
+
+    bool isValid() const;
+    bool isReady() const;
+    void wait() const;
+    bool waitFor(const std::chrono::milliseconds& timeout) const;
+    void cancel() const;
+
+    SolveResult getResult() const;
+    int getNodesExplored() const;
+    double getElapsedMillis() const;
+    std::string getStrategyName() const;
+};
+
+
+// Fixed set of worker threads draining a FIFO of solve jobs. Each job owns
+// its strategy and a shared, read-only maze snapshot, so many jobs can be
+// in flight while only getThreadCount() of them run at once. submit() does
+// no per-cell work on the caller's thread: the snapshot is the caller's,
+// and solvers that want the reachability index build it on the worker.
+class SolverPool {
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<SolveJob>> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    bool stopping_;
+
+    void workerLoop();
+    static void runJob(SolveJob& job);
+
+public:
+    explicit SolverPool(int threads = 0);
+    ~SolverPool();
+
+    SolverPool(const SolverPool&) = delete;
+    SolverPool& operator=(const SolverPool&) = delete;
+
+    static SolverPool& shared();
+
+    SolveHandle submit(const std::shared_ptr<const Maze>& maze,
+                       std::unique_ptr<MazeSolverStrategy> strategy,
+                       const SolveOptions& options = SolveOptions(),
+                       const std::function<void()>& onFinished = std::function<void()>());
+
+    int getThreadCount() const;
+    int getPendingCount() const;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef SUBGOALGRAPH_H
+#define SUBGOALGRAPH_H
+
+#include "DijkstraSolver.h"
+#include "Maze.h"
+#include "MazeSolverStrategy.h"
+#include "Path.h"
+#include "Point.h"
+#include "SolveOptions.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+class SubgoalGraph {
+private:
+    int width_;
+    int height_;
+    std::uint64_t revision_;
+    bool built_;
+
+    std::vector<int> subgoalOfCell_;
+    std::vector<int> subgoalCells_;
+    std::vector<int> edgeOffsets_;
+    std::vector<int> edgeTargets_;
+
+    mutable std::vector<int> stamp_;
+    mutable int generation_;
+    mutable std::vector<int> frontier_;
+
+    bool isCorner(const Maze& maze, int x, int y) const;
+    void findDirect(const Maze& maze, int origin, int target, std::vector<int>& subgoals, bool& reachedTarget) const;
+    int distance(int a, int b) const;
+    void appendSegment(const Maze& maze, int from, int to, Path& path) const;
+
+public:
+    SubgoalGraph();
+
+    bool build(const Maze& maze);
+    bool isBuilt() const;
+    bool matches(const Maze& maze) const;
+    void clear();
+
+    int getSubgoalCount() const;
+    int getEdgeCount() const;
+
+    SolveResult findPath(const Maze& maze, const Point& start, const Point& goal,
+                         const SolveOptions& options, int& nodesExplored) const;
+};
+
+
+class SubgoalSolver : public MazeSolverStrategy {
+private:
+    SubgoalGraph graph_;
+    DijkstraSolver fallback_;
+    int nodesExplored_;
+    bool usedFallback_;
+
+public:
+    SubgoalSolver();
+
+    bool prepare(const Maze& maze);
+    const SubgoalGraph& getGraph() const;
+    bool usedFallback() const;
+
+    SolveResult solveWithOptions(const Maze& maze, const SolveOptions& options) override;
+    int getNodesExplored() const override;
+    std::string name() const override;
+};
+
+#endif
@@ -0,0 +1,30 @@
+#include "AStarSolver.h"
+
+namespace {
+    // Expansions between deadline and cancellation checks, matching the
+    // granularity SolveBudget uses for the one-shot solvers.
+    const int kChunkNodes = 256;
+}
+
+AStarSolver::AStarSolver() : search_(), nodesExplored_(0) {}
+
+SolveResult AStarSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
+    if (!maze.areConnected(maze.getStart(), maze.getGoal())) {
+        nodesExplored_ = 0;
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
+    search_.begin(maze, options);
+    while (!search_.step(kChunkNodes)) {
+    }
+    nodesExplored_ = search_.getNodesExplored();
+    return search_.result();
+}
+
+int AStarSolver::getNodesExplored() const {
+    return nodesExplored_;
+}
+
+std::string AStarSolver::name() const {
+    return "A* Search";
+}
@@ -59,15 +59,22 @@ Path BFSSolver::reconstructPath(const Point& start, const Point& goal, int width
     return path;
 }
 
-Path BFSSolver::solve(const Maze& maze) {
+SolveResult BFSSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
     Point start = maze.getStart();
     Point goal = maze.getGoal();
     int width = maze.getWidth();
     int height = maze.getHeight();
 
+    if (!maze.areConnected(start, goal)) {
+        parent_.clear();
+        visited_.clear();
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
     parent_.assign(static_cast<std::size_t>(width * height), Point(-1, -1));
     visited_.assign(static_cast<std::size_t>(width * height), false);
 
+    SolveBudget budget(options);
     PointQueue queue;
     queue.enqueue(start);
     visited_[static_cast<std::size_t>(pointToIndex(start, width))] = true;
@@ -75,6 +82,10 @@ Path BFSSolver::solve(const Maze& maze) {
     bool found = false;
 
     while (!queue.isEmpty()) {
+        if (!budget.consume()) {
+            return SolveResult(budget.getStopStatus());
+        }
+
         Point current = queue.dequeue();
 
         if (current == goal) {
@@ -92,7 +103,8 @@ Path BFSSolver::solve(const Maze& maze) {
 
             if (neighborIdx >= 0 &&
                 neighborIdx < static_cast<int>(visited_.size()) &&
-                !visited_[static_cast<std::size_t>(neighborIdx)]) {
+                !visited_[static_cast<std::size_t>(neighborIdx)] &&
+                options.isCellAllowed(neighborIdx)) {
                 visited_[static_cast<std::size_t>(neighborIdx)] = true;
                 parent_[static_cast<std::size_t>(neighborIdx)] = current;
                 queue.enqueue(neighbor);
@@ -101,10 +113,10 @@ Path BFSSolver::solve(const Maze& maze) {
     }
 
     if (found) {
-        return reconstructPath(start, goal, width);
+        return SolveResult(SolveStatus::Found, reconstructPath(start, goal, width));
     }
 
-    return Path();
+    return SolveResult(SolveStatus::Unreachable);
 }
 
 int BFSSolver::getNodesExplored() const {
@@ -0,0 +1,299 @@
+#include "BidirectionalDijkstraSolver.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    const double kInfinity = std::numeric_limits<double>::infinity();
+}
+
+BidirectionalDijkstraSolver::BidirectionalDijkstraSolver()
+    : bestCost_(kInfinity),
+      abort_(false),
+      meetingCell_(-1),
+      nodesExplored_(0),
+      threaded_(std::thread::hardware_concurrency() > 1),
+      restriction_(nullptr),
+      helper_(),
+      helperMaze_(nullptr),
+      helperOptions_(nullptr),
+      helperPending_(false),
+      helperStopping_(false) {}
+
+BidirectionalDijkstraSolver::~BidirectionalDijkstraSolver() {
+    if (helper_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(helperMutex_);
+            helperStopping_ = true;
+        }
+        helperWake_.notify_one();
+        helper_.join();
+    }
+}
+
+void BidirectionalDijkstraSolver::helperLoop() {
+    std::unique_lock<std::mutex> lock(helperMutex_);
+    while (true) {
+        helperWake_.wait(lock, [this] { return helperPending_ || helperStopping_; });
+        if (helperStopping_) {
+            return;
+        }
+        lock.unlock();
+        search(*helperMaze_, false, *helperOptions_);
+        lock.lock();
+        helperPending_ = false;
+        helperDone_.notify_one();
+    }
+}
+
+// State arrays follow the maze's own padded layout, so neighbours come
+// from the open mask and index arithmetic instead of Point lookups.
+void BidirectionalDijkstraSolver::prepare(const Maze& maze) {
+    std::size_t cells = maze.cellCount();
+
+    Side* sides[2] = {&forward_, &backward_};
+    for (Side* side : sides) {
+        if (side->capacity < cells) {
+            side->distance.reset(new std::atomic<double>[cells]);
+            side->capacity = cells;
+        }
+        for (std::size_t i = 0; i < cells; i++) {
+            side->distance[i].store(kInfinity, std::memory_order_relaxed);
+        }
+        side->heap = Queue();
+        side->parent.assign(cells, -1);
+        side->touched.clear();
+        side->top.store(0.0, std::memory_order_relaxed);
+        side->nodesExplored = 0;
+        side->stopStatus = SolveStatus::Found;
+        side->stopped = false;
+    }
+
+    bestCost_.store(kInfinity, std::memory_order_relaxed);
+    abort_.store(false, std::memory_order_relaxed);
+    meetingCell_ = -1;
+}
+
+// Masks are indexed without the sentinel border, so the padded cell is
+// translated back first.
+bool BidirectionalDijkstraSolver::isAllowed(const Maze& maze, int cell) const {
+    Point p = maze.cellPoint(cell);
+    return restriction_->isCellAllowed(p.getY() * maze.getWidth() + p.getX());
+}
+
+void BidirectionalDijkstraSolver::offerMeeting(double cost, int cell) {
+    std::lock_guard<std::mutex> lock(meetingMutex_);
+    if (cost < bestCost_.load(std::memory_order_relaxed)) {
+        bestCost_.store(cost, std::memory_order_release);
+        meetingCell_ = cell;
+    }
+}
+
+// Per-cell distances are relaxed, so while the searches run a meeting may
+// go unseen by both sides. That only delays the stopping test; once both
+// searches are joined every distance is visible and the exact meeting is
+// the cheapest forward + backward sum over the cells either side reached.
+void BidirectionalDijkstraSolver::settleMeeting() {
+    const Side& smaller = forward_.touched.size() <= backward_.touched.size() ? forward_ : backward_;
+    double best = bestCost_.load(std::memory_order_relaxed);
+    for (int cell : smaller.touched) {
+        std::size_t i = static_cast<std::size_t>(cell);
+        double total = forward_.distance[i].load(std::memory_order_relaxed) +
+                       backward_.distance[i].load(std::memory_order_relaxed);
+        if (total < best) {
+            best = total;
+            meetingCell_ = cell;
+        }
+    }
+    bestCost_.store(best, std::memory_order_relaxed);
+}
+
+// Settles one cell for one direction; false once that side is done. The
+// forward side charges the cost of the cell it enters; the backward side
+// charges the cell it leaves, so the two distances add up to a start-goal
+// cost at every cell.
+bool BidirectionalDijkstraSolver::expand(const Maze& maze, bool isForward, SolveBudget& budget) {
+    Side& self = isForward ? forward_ : backward_;
+    Side& other = isForward ? backward_ : forward_;
+
+    while (!self.heap.empty()) {
+        QueueItem item = self.heap.top();
+        self.heap.pop();
+
+        const int u = item.second;
+        const double du = item.first;
+        if (du > self.distance[static_cast<std::size_t>(u)].load(std::memory_order_relaxed)) continue;
+
+        // Standard stopping rule: once the two queue minima add up to the
+        // best meeting cost, no unexplored path can be cheaper. Stale
+        // values only make the test fire later.
+        self.top.store(du, std::memory_order_relaxed);
+        if (du + other.top.load(std::memory_order_relaxed) >= bestCost_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        if (!budget.consume()) {
+            self.stopStatus = budget.getStopStatus();
+            self.stopped = true;
+            abort_.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        self.nodesExplored++;
+
+        const int mask = maze.getOpenMaskAtIndex(u);
+        const double leaveCost = isForward ? 0.0 : maze.getCellCostAtIndex(u);
+        for (int dir = 0; dir < 4; dir++) {
+            if (!((mask >> dir) & 1)) continue;
+
+            const int v = maze.neighborIndex(u, dir);
+            if (restriction_ && !isAllowed(maze, v)) continue;
+            const double candidate = du + (isForward ? maze.getCellCostAtIndex(v) : leaveCost);
+            std::atomic<double>& dv = self.distance[static_cast<std::size_t>(v)];
+            if (candidate >= dv.load(std::memory_order_relaxed)) continue;
+
+            if (dv.load(std::memory_order_relaxed) == kInfinity) {
+                self.touched.push_back(v);
+            }
+            dv.store(candidate, std::memory_order_relaxed);
+            self.parent[static_cast<std::size_t>(v)] = u;
+            self.heap.push(QueueItem(candidate, v));
+
+            double across = other.distance[static_cast<std::size_t>(v)].load(std::memory_order_relaxed);
+            if (candidate + across < bestCost_.load(std::memory_order_relaxed)) {
+                offerMeeting(candidate + across, v);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+void BidirectionalDijkstraSolver::search(const Maze& maze, bool isForward, const SolveOptions& options) {
+    Side& self = isForward ? forward_ : backward_;
+    SolveBudget budget(options);
+    while (!abort_.load(std::memory_order_relaxed) && expand(maze, isForward, budget)) {
+    }
+
+    // An exhausted side can never lower the bound again; let the other
+    // side's stopping test see that.
+    self.top.store(kInfinity, std::memory_order_relaxed);
+}
+
+// Single-core variant: always advance the side with the smaller queue
+// minimum, so both frontiers grow evenly without a second thread.
+void BidirectionalDijkstraSolver::searchInterleaved(const Maze& maze, const SolveOptions& options) {
+    SolveBudget forwardBudget(options);
+    SolveBudget backwardBudget(options);
+    bool forwardAlive = true;
+    bool backwardAlive = true;
+
+    while ((forwardAlive || backwardAlive) && !abort_.load(std::memory_order_relaxed)) {
+        bool pickForward = forwardAlive &&
+                           (!backwardAlive || backward_.heap.empty() ||
+                            (!forward_.heap.empty() && forward_.heap.top().first <= backward_.heap.top().first));
+        if (pickForward) {
+            forwardAlive = expand(maze, true, forwardBudget);
+            if (!forwardAlive) forward_.top.store(kInfinity, std::memory_order_relaxed);
+        } else {
+            backwardAlive = expand(maze, false, backwardBudget);
+            if (!backwardAlive) backward_.top.store(kInfinity, std::memory_order_relaxed);
+        }
+    }
+}
+
+Path BidirectionalDijkstraSolver::reconstruct(const Maze& maze) const {
+    std::vector<int> cells;
+    for (int c = meetingCell_; c != -1; c = forward_.parent[static_cast<std::size_t>(c)]) {
+        cells.push_back(c);
+    }
+    std::reverse(cells.begin(), cells.end());
+    for (int c = backward_.parent[static_cast<std::size_t>(meetingCell_)]; c != -1;
+         c = backward_.parent[static_cast<std::size_t>(c)]) {
+        cells.push_back(c);
+    }
+
+    Path path;
+    double cost = 0.0;
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        path.addPoint(maze.cellPoint(cells[i]));
+        if (i > 0) cost += maze.getCellCostAtIndex(cells[i]);
+    }
+    path.setCost(cost);
+    return path;
+}
+
+SolveResult BidirectionalDijkstraSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
+    nodesExplored_ = 0;
+    Point start = maze.getStart();
+    Point goal = maze.getGoal();
+
+    // Builds the reachability index here, before the helper can race on it.
+    if (!maze.areConnected(start, goal)) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
+    const int startCell = maze.cellIndex(start);
+    const int goalCell = maze.cellIndex(goal);
+    restriction_ = options.hasAllowedCells() ? &options : nullptr;
+    if (restriction_ && !isAllowed(maze, goalCell)) {
+        restriction_ = nullptr;
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
+    prepare(maze);
+    forward_.distance[static_cast<std::size_t>(startCell)].store(0.0, std::memory_order_relaxed);
+    backward_.distance[static_cast<std::size_t>(goalCell)].store(0.0, std::memory_order_relaxed);
+
+    forward_.heap.push(QueueItem(0.0, startCell));
+    backward_.heap.push(QueueItem(0.0, goalCell));
+    forward_.touched.push_back(startCell);
+    backward_.touched.push_back(goalCell);
+
+    if (threaded_) {
+        {
+            std::lock_guard<std::mutex> lock(helperMutex_);
+            if (!helper_.joinable()) {
+                helper_ = std::thread(&BidirectionalDijkstraSolver::helperLoop, this);
+            }
+            helperMaze_ = &maze;
+            helperOptions_ = &options;
+            helperPending_ = true;
+        }
+        helperWake_.notify_one();
+        search(maze, true, options);
+        std::unique_lock<std::mutex> lock(helperMutex_);
+        helperDone_.wait(lock, [this] { return !helperPending_; });
+    } else {
+        searchInterleaved(maze, options);
+    }
+
+    restriction_ = nullptr;
+    nodesExplored_ = forward_.nodesExplored + backward_.nodesExplored;
+    if (forward_.stopped) {
+        return SolveResult(forward_.stopStatus);
+    }
+    if (backward_.stopped) {
+        return SolveResult(backward_.stopStatus);
+    }
+    settleMeeting();
+    if (meetingCell_ < 0) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+    return SolveResult(SolveStatus::Found, reconstruct(maze));
+}
+
+void BidirectionalDijkstraSolver::setThreaded(bool threaded) {
+    threaded_ = threaded;
+}
+
+bool BidirectionalDijkstraSolver::isThreaded() const {
+    return threaded_;
+}
+
+int BidirectionalDijkstraSolver::getNodesExplored() const {
+    return nodesExplored_;
+}
+
+std::string BidirectionalDijkstraSolver::name() const {
+    return threaded_ ? "Bidirectional Dijkstra (2 threads)" : "Bidirectional Dijkstra (1 thread)";
+}
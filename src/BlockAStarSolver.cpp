@@ -0,0 +1,304 @@
+#include "BlockAStarSolver.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+    const int B = LocalDistanceTable::kBlockSize;
+    const int kInfinity = INT_MAX / 2;
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+
+    typedef std::pair<int, int> QueueItem;
+}
+
+const unsigned char* LocalDistanceTable::lookup(std::uint16_t wallMask) {
+    if (tables_.empty()) {
+        tables_.resize(1u << kCells);
+    }
+    std::unique_ptr<unsigned char[]>& table = tables_[wallMask];
+    if (!table) {
+        table.reset(new unsigned char[kCells * kCells]);
+        compute(wallMask, table.get());
+        computed_++;
+    }
+    return table.get();
+}
+
+int LocalDistanceTable::getComputedCount() const {
+    return computed_;
+}
+
+// All-pairs BFS distances inside one block, moving only through its own
+// open cells. Row i holds the distances from local cell i.
+void LocalDistanceTable::compute(std::uint16_t wallMask, unsigned char* table) {
+    std::fill(table, table + kCells * kCells, kUnreachable);
+
+    int queue[kCells];
+    for (int source = 0; source < kCells; source++) {
+        if (wallMask & (1u << source)) continue;
+
+        unsigned char* row = table + source * kCells;
+        row[source] = 0;
+        int head = 0, tail = 0;
+        queue[tail++] = source;
+        while (head < tail) {
+            int u = queue[head++];
+            int ux = u % kBlockSize;
+            int uy = u / kBlockSize;
+            for (int dir = 0; dir < 4; dir++) {
+                int vx = ux + kDx[dir];
+                int vy = uy + kDy[dir];
+                if (vx < 0 || vx >= kBlockSize || vy < 0 || vy >= kBlockSize) continue;
+                int v = vy * kBlockSize + vx;
+                if ((wallMask & (1u << v)) || row[v] != kUnreachable) continue;
+                row[v] = static_cast<unsigned char>(row[u] + 1);
+                queue[tail++] = v;
+            }
+        }
+    }
+}
+
+BlockAStarSolver::BlockAStarSolver()
+    : width_(0), height_(0), blocksX_(0), blocksY_(0), nodesExplored_(0), heapOperations_(0),
+      fallback_(), usedFallback_(false) {}
+
+int BlockAStarSolver::blockOf(int x, int y) const {
+    return (y / B) * blocksX_ + (x / B);
+}
+
+int BlockAStarSolver::localOf(int x, int y) const {
+    return (y % B) * B + (x % B);
+}
+
+int BlockAStarSolver::cellOf(int block, int local) const {
+    int x = (block % blocksX_) * B + local % B;
+    int y = (block / blocksX_) * B + local / B;
+    return y * width_ + x;
+}
+
+// Cells beyond the right and bottom edges count as walls so partial blocks
+// share the same tables.
+void BlockAStarSolver::loadBlocks(const Maze& maze) {
+    width_ = maze.getWidth();
+    height_ = maze.getHeight();
+    blocksX_ = (width_ + B - 1) / B;
+    blocksY_ = (height_ + B - 1) / B;
+
+    std::size_t blocks = static_cast<std::size_t>(blocksX_ * blocksY_);
+    wallMasks_.assign(blocks, 0);
+    pending_.assign(blocks, 0);
+    blockKey_.assign(blocks, kInfinity);
+    g_.assign(static_cast<std::size_t>(width_ * height_), kInfinity);
+    parent_.assign(static_cast<std::size_t>(width_ * height_), -1);
+
+    for (int by = 0; by < blocksY_; by++) {
+        for (int bx = 0; bx < blocksX_; bx++) {
+            std::uint16_t mask = 0;
+            for (int local = 0; local < B * B; local++) {
+                Point p(bx * B + local % B, by * B + local / B);
+                if (!maze.isWalkable(p)) {
+                    mask = static_cast<std::uint16_t>(mask | (1u << local));
+                }
+            }
+            wallMasks_[static_cast<std::size_t>(by * blocksX_ + bx)] = mask;
+        }
+    }
+}
+
+SolveResult BlockAStarSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
+    nodesExplored_ = 0;
+    heapOperations_ = 0;
+
+    // Local distance tables count steps and span whole blocks, so terrain
+    // mazes and restricted searches go to Dijkstra.
+    usedFallback_ = !maze.hasUniformCosts() || options.hasAllowedCells();
+    if (usedFallback_) {
+        SolveResult result = fallback_.solveWithOptions(maze, options);
+        nodesExplored_ = fallback_.getNodesExplored();
+        return result;
+    }
+
+    Point start = maze.getStart();
+    Point goal = maze.getGoal();
+    if (!maze.areConnected(start, goal)) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
+    loadBlocks(maze);
+
+    const int gx = goal.getX();
+    const int gy = goal.getY();
+    const int goalCell = gy * width_ + gx;
+    auto heuristic = [gx, gy, this](int cell) {
+        return std::abs(cell % width_ - gx) + std::abs(cell / width_ - gy);
+    };
+
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+    auto schedule = [&](int cell) {
+        int x = cell % width_;
+        int y = cell / width_;
+        int block = blockOf(x, y);
+        pending_[static_cast<std::size_t>(block)] =
+            static_cast<std::uint16_t>(pending_[static_cast<std::size_t>(block)] | (1u << localOf(x, y)));
+        int key = g_[static_cast<std::size_t>(cell)] + heuristic(cell);
+        if (key < blockKey_[static_cast<std::size_t>(block)]) {
+            blockKey_[static_cast<std::size_t>(block)] = key;
+            open.push(QueueItem(key, block));
+            heapOperations_++;
+        }
+    };
+
+    const int startCell = start.getY() * width_ + start.getX();
+    g_[static_cast<std::size_t>(startCell)] = 0;
+    schedule(startCell);
+
+    SolveBudget budget(options);
+    while (!open.empty()) {
+        QueueItem top = open.top();
+        open.pop();
+        heapOperations_++;
+
+        const int block = top.second;
+        const std::size_t b = static_cast<std::size_t>(block);
+        if (top.first != blockKey_[b] || pending_[b] == 0) continue;
+
+        // Every pending ingress cell carries a lower bound of top.first, so
+        // nothing left in the heap can improve the goal any more.
+        if (top.first >= g_[static_cast<std::size_t>(goalCell)]) break;
+
+        if (!budget.consume()) {
+            return SolveResult(budget.getStopStatus());
+        }
+        nodesExplored_++;
+
+        std::uint16_t ingress = pending_[b];
+        pending_[b] = 0;
+        blockKey_[b] = kInfinity;
+
+        const unsigned char* table = localDistances_.lookup(wallMasks_[b]);
+        int cells[B * B];
+        for (int local = 0; local < B * B; local++) {
+            cells[local] = cellOf(block, local);
+        }
+
+        std::uint16_t improved = ingress;
+        for (int i = 0; i < B * B; i++) {
+            if (!(ingress & (1u << i))) continue;
+            const int gi = g_[static_cast<std::size_t>(cells[i])];
+            const unsigned char* row = table + i * B * B;
+            for (int c = 0; c < B * B; c++) {
+                if (row[c] == LocalDistanceTable::kUnreachable) continue;
+                int candidate = gi + row[c];
+                if (candidate < g_[static_cast<std::size_t>(cells[c])]) {
+                    g_[static_cast<std::size_t>(cells[c])] = candidate;
+                    parent_[static_cast<std::size_t>(cells[c])] = cells[i];
+                    improved = static_cast<std::uint16_t>(improved | (1u << c));
+                }
+            }
+        }
+
+        // Only cells on the block's rim can hand their distance to a
+        // neighbouring block.
+        for (int c = 0; c < B * B; c++) {
+            if (!(improved & (1u << c))) continue;
+            const int cx = c % B;
+            const int cy = c / B;
+            if (cx != 0 && cx != B - 1 && cy != 0 && cy != B - 1) continue;
+
+            const int cell = cells[c];
+            const int gc = g_[static_cast<std::size_t>(cell)];
+            const int x = cell % width_;
+            const int y = cell / width_;
+            for (int dir = 0; dir < 4; dir++) {
+                int lx = cx + kDx[dir];
+                int ly = cy + kDy[dir];
+                if (lx >= 0 && lx < B && ly >= 0 && ly < B) continue;
+
+                Point next(x + kDx[dir], y + kDy[dir]);
+                if (!maze.isWalkable(next)) continue;
+                int nextCell = next.getY() * width_ + next.getX();
+                if (gc + 1 < g_[static_cast<std::size_t>(nextCell)]) {
+                    g_[static_cast<std::size_t>(nextCell)] = gc + 1;
+                    parent_[static_cast<std::size_t>(nextCell)] = cell;
+                    schedule(nextCell);
+                }
+            }
+        }
+    }
+
+    if (g_[static_cast<std::size_t>(goalCell)] >= kInfinity) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+    return SolveResult(SolveStatus::Found, reconstruct(start, goal, maze.getCellCost(start)));
+}
+
+// Parents either cross a block edge (one step) or jump to the ingress cell
+// the local table measured from; the latter is expanded back into single
+// steps by descending that ingress row of the table.
+Path BlockAStarSolver::reconstruct(const Point& start, const Point& goal, double stepCost) {
+    const int startCell = start.getY() * width_ + start.getX();
+    std::vector<Point> reverse;
+
+    int cell = goal.getY() * width_ + goal.getX();
+    reverse.push_back(goal);
+    while (cell != startCell) {
+        int from = parent_[static_cast<std::size_t>(cell)];
+        int x = cell % width_, y = cell / width_;
+        int fx = from % width_, fy = from / width_;
+        int block = blockOf(x, y);
+
+        if (blockOf(fx, fy) == block) {
+            const unsigned char* row = localDistances_.lookup(wallMasks_[static_cast<std::size_t>(block)]) +
+                                       localOf(fx, fy) * B * B;
+            int local = localOf(x, y);
+            while (row[local] > 0) {
+                int lx = local % B, ly = local / B;
+                for (int dir = 0; dir < 4; dir++) {
+                    int nx = lx + kDx[dir], ny = ly + kDy[dir];
+                    if (nx < 0 || nx >= B || ny < 0 || ny >= B) continue;
+                    int n = ny * B + nx;
+                    if (row[n] + 1 == row[local]) {
+                        local = n;
+                        break;
+                    }
+                }
+                reverse.push_back(Point(fx - fx % B + local % B, fy - fy % B + local / B));
+            }
+        } else {
+            reverse.push_back(Point(fx, fy));
+        }
+        cell = from;
+    }
+
+    Path path;
+    for (auto it = reverse.rbegin(); it != reverse.rend(); ++it) {
+        path.addPoint(*it);
+    }
+    path.setCost(stepCost * (path.getSize() - 1));
+    return path;
+}
+
+int BlockAStarSolver::getNodesExplored() const {
+    return nodesExplored_;
+}
+
+std::string BlockAStarSolver::name() const {
+    return "Block A*";
+}
+
+long long BlockAStarSolver::getHeapOperations() const {
+    return heapOperations_;
+}
+
+int BlockAStarSolver::getLocalTablesComputed() const {
+    return localDistances_.getComputedCount();
+}
+
+bool BlockAStarSolver::usedFallback() const {
+    return usedFallback_;
+}
@@ -0,0 +1,281 @@
+#include "BlockCutTree.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+
+    struct Frame {
+        int cell;
+        int parent;
+        int nextDirection;
+        int children;
+    };
+}
+
+BlockCutTree::BlockCutTree() : width_(0), height_(0), built_(false) {}
+
+int BlockCutTree::blockCount() const {
+    return static_cast<int>(blockOffsets_.size()) - 1;
+}
+
+// Tree nodes are the blocks followed by one node per articulation cell.
+int BlockCutTree::treeNodeOf(int cell) const {
+    int cut = cutOfCell_[static_cast<std::size_t>(cell)];
+    if (cut >= 0) {
+        return blockCount() + cut;
+    }
+    return blockOfCell_[static_cast<std::size_t>(cell)];
+}
+
+// Iterative Tarjan over the open cells with an explicit edge stack. When a
+// child's low link cannot climb above its parent, the edges pushed since the
+// tree edge form one biconnected block and the parent separates it.
+void BlockCutTree::findBlocks(const Maze& maze) {
+    const std::size_t cells = static_cast<std::size_t>(width_ * height_);
+    std::vector<int> discovery(cells, -1);
+    std::vector<int> low(cells, 0);
+    std::vector<int> stamp(cells, -1);
+    std::vector<Frame> stack;
+    std::vector<std::pair<int, int>> edges;
+    int time = 0;
+
+    blockOffsets_.assign(1, 0);
+    auto closeBlock = [&](int u, int v) {
+        int block = blockCount();
+        auto addCell = [&](int c) {
+            if (stamp[static_cast<std::size_t>(c)] == block) return;
+            stamp[static_cast<std::size_t>(c)] = block;
+            blockCells_.push_back(c);
+            blockOfCell_[static_cast<std::size_t>(c)] = block;
+        };
+        while (!edges.empty()) {
+            std::pair<int, int> e = edges.back();
+            edges.pop_back();
+            addCell(e.first);
+            addCell(e.second);
+            if (e.first == u && e.second == v) break;
+        }
+        blockOffsets_.push_back(static_cast<int>(blockCells_.size()));
+    };
+
+    auto markCut = [&](int cell) {
+        if (cutOfCell_[static_cast<std::size_t>(cell)] < 0) {
+            cutOfCell_[static_cast<std::size_t>(cell)] = static_cast<int>(articulationCells_.size());
+            articulationCells_.push_back(cell);
+        }
+    };
+
+    for (int root = 0; root < width_ * height_; root++) {
+        if (discovery[static_cast<std::size_t>(root)] >= 0) continue;
+        if (!maze.isWalkable(Point(root % width_, root / width_))) continue;
+
+        discovery[static_cast<std::size_t>(root)] = low[static_cast<std::size_t>(root)] = time++;
+        Frame start = {root, -1, 0, 0};
+        stack.push_back(start);
+
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            const int v = top.cell;
+
+            if (top.nextDirection < 4) {
+                int dir = top.nextDirection++;
+                Point next(v % width_ + kDx[dir], v / width_ + kDy[dir]);
+                if (!maze.isWalkable(next)) continue;
+
+                int w = next.getY() * width_ + next.getX();
+                if (w == top.parent) continue;
+
+                if (discovery[static_cast<std::size_t>(w)] < 0) {
+                    top.children++;
+                    edges.push_back(std::make_pair(v, w));
+                    discovery[static_cast<std::size_t>(w)] = low[static_cast<std::size_t>(w)] = time++;
+                    Frame child = {w, v, 0, 0};
+                    stack.push_back(child);
+                } else if (discovery[static_cast<std::size_t>(w)] < discovery[static_cast<std::size_t>(v)]) {
+                    edges.push_back(std::make_pair(v, w));
+                    low[static_cast<std::size_t>(v)] = std::min(low[static_cast<std::size_t>(v)],
+                                                                discovery[static_cast<std::size_t>(w)]);
+                }
+                continue;
+            }
+
+            const int parent = top.parent;
+            const int children = top.children;
+            stack.pop_back();
+
+            if (parent < 0) {
+                if (children > 1) markCut(v);
+                if (children == 0) {
+                    // An isolated open cell is a block of its own.
+                    blockCells_.push_back(v);
+                    blockOfCell_[static_cast<std::size_t>(v)] = blockCount();
+                    blockOffsets_.push_back(static_cast<int>(blockCells_.size()));
+                }
+                continue;
+            }
+
+            low[static_cast<std::size_t>(parent)] = std::min(low[static_cast<std::size_t>(parent)],
+                                                             low[static_cast<std::size_t>(v)]);
+            if (low[static_cast<std::size_t>(v)] >= discovery[static_cast<std::size_t>(parent)]) {
+                if (stack.back().parent >= 0) markCut(parent);
+                closeBlock(parent, v);
+            }
+        }
+    }
+}
+
+// Roots every component of the block-cut forest so a query can climb from
+// both ends to their meeting node.
+void BlockCutTree::buildTree() {
+    const int blocks = blockCount();
+    const int nodes = blocks + static_cast<int>(articulationCells_.size());
+
+    std::vector<std::vector<int>> adjacency(static_cast<std::size_t>(nodes));
+    for (int b = 0; b < blocks; b++) {
+        for (int i = blockOffsets_[static_cast<std::size_t>(b)]; i < blockOffsets_[static_cast<std::size_t>(b) + 1]; i++) {
+            int cut = cutOfCell_[static_cast<std::size_t>(blockCells_[static_cast<std::size_t>(i)])];
+            if (cut >= 0) {
+                adjacency[static_cast<std::size_t>(b)].push_back(blocks + cut);
+                adjacency[static_cast<std::size_t>(blocks + cut)].push_back(b);
+            }
+        }
+    }
+
+    treeParent_.assign(static_cast<std::size_t>(nodes), -1);
+    treeDepth_.assign(static_cast<std::size_t>(nodes), -1);
+    treeRoot_.assign(static_cast<std::size_t>(nodes), -1);
+
+    std::vector<int> queue;
+    for (int root = 0; root < nodes; root++) {
+        if (treeDepth_[static_cast<std::size_t>(root)] >= 0) continue;
+        treeDepth_[static_cast<std::size_t>(root)] = 0;
+        treeRoot_[static_cast<std::size_t>(root)] = root;
+        queue.assign(1, root);
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            int u = queue[head];
+            for (int v : adjacency[static_cast<std::size_t>(u)]) {
+                if (treeDepth_[static_cast<std::size_t>(v)] >= 0) continue;
+                treeDepth_[static_cast<std::size_t>(v)] = treeDepth_[static_cast<std::size_t>(u)] + 1;
+                treeParent_[static_cast<std::size_t>(v)] = u;
+                treeRoot_[static_cast<std::size_t>(v)] = root;
+                queue.push_back(v);
+            }
+        }
+    }
+}
+
+bool BlockCutTree::build(const Maze& maze) {
+    clear();
+    width_ = maze.getWidth();
+    height_ = maze.getHeight();
+
+    std::size_t cells = static_cast<std::size_t>(width_ * height_);
+    blockOfCell_.assign(cells, -1);
+    cutOfCell_.assign(cells, -1);
+
+    findBlocks(maze);
+    buildTree();
+    built_ = true;
+    return true;
+}
+
+bool BlockCutTree::isBuilt() const {
+    return built_;
+}
+
+void BlockCutTree::clear() {
+    width_ = 0;
+    height_ = 0;
+    built_ = false;
+    blockOfCell_.clear();
+    cutOfCell_.clear();
+    blockOffsets_.clear();
+    blockCells_.clear();
+    articulationCells_.clear();
+    treeParent_.clear();
+    treeDepth_.clear();
+    treeRoot_.clear();
+}
+
+int BlockCutTree::getBlockCount() const {
+    return built_ ? blockCount() : 0;
+}
+
+int BlockCutTree::getLargestBlockSize() const {
+    int largest = 0;
+    for (int b = 0; b < getBlockCount(); b++) {
+        largest = std::max(largest, blockOffsets_[static_cast<std::size_t>(b) + 1] - blockOffsets_[static_cast<std::size_t>(b)]);
+    }
+    return largest;
+}
+
+const std::vector<int>& BlockCutTree::getArticulationCells() const {
+    return articulationCells_;
+}
+
+bool BlockCutTree::isArticulation(const Point& p) const {
+    if (!built_ || p.getX() < 0 || p.getX() >= width_ || p.getY() < 0 || p.getY() >= height_) {
+        return false;
+    }
+    return cutOfCell_[static_cast<std::size_t>(p.getY() * width_ + p.getX())] >= 0;
+}
+
+std::vector<Point> BlockCutTree::getChokepoints() const {
+    std::vector<Point> points;
+    points.reserve(articulationCells_.size());
+    for (int cell : articulationCells_) {
+        points.push_back(Point(cell % width_, cell / width_));
+    }
+    return points;
+}
+
+// Every simple start-goal path stays inside the blocks on the tree path
+// between their nodes, so all other cells can be dropped from the search.
+bool BlockCutTree::getCorridor(const Point& start, const Point& goal, std::vector<bool>& allowed) const {
+    allowed.assign(static_cast<std::size_t>(width_ * height_), false);
+    if (!built_ || start.getX() < 0 || start.getX() >= width_ || start.getY() < 0 || start.getY() >= height_ ||
+        goal.getX() < 0 || goal.getX() >= width_ || goal.getY() < 0 || goal.getY() >= height_) {
+        return false;
+    }
+
+    int a = treeNodeOf(start.getY() * width_ + start.getX());
+    int b = treeNodeOf(goal.getY() * width_ + goal.getX());
+    if (a < 0 || b < 0 || treeRoot_[static_cast<std::size_t>(a)] != treeRoot_[static_cast<std::size_t>(b)]) {
+        return false;
+    }
+
+    const int blocks = blockCount();
+    auto allowNode = [&](int node) {
+        if (node >= blocks) {
+            allowed[static_cast<std::size_t>(articulationCells_[static_cast<std::size_t>(node - blocks)])] = true;
+            return;
+        }
+        for (int i = blockOffsets_[static_cast<std::size_t>(node)]; i < blockOffsets_[static_cast<std::size_t>(node) + 1]; i++) {
+            allowed[static_cast<std::size_t>(blockCells_[static_cast<std::size_t>(i)])] = true;
+        }
+    };
+
+    while (a != b) {
+        if (treeDepth_[static_cast<std::size_t>(a)] >= treeDepth_[static_cast<std::size_t>(b)]) {
+            allowNode(a);
+            a = treeParent_[static_cast<std::size_t>(a)];
+        } else {
+            allowNode(b);
+            b = treeParent_[static_cast<std::size_t>(b)];
+        }
+    }
+    allowNode(a);
+    return true;
+}
+
+bool BlockCutTree::restrictSearch(const Point& start, const Point& goal, SolveOptions& options) const {
+    std::shared_ptr<std::vector<bool>> allowed = std::make_shared<std::vector<bool>>();
+    if (!getCorridor(start, goal, *allowed)) {
+        return false;
+    }
+    options.setAllowedCells(allowed);
+    return true;
+}
@@ -0,0 +1,482 @@
+#include "CooperativePlanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace {
+    const int kDx[5] = {0, 0, 1, 0, -1};
+    const int kDy[5] = {0, -1, 0, 1, 0};
+    const double kInfinity = std::numeric_limits<double>::infinity();
+    const double kWaitCost = 1.0;
+
+    typedef std::pair<double, int> QueueItem;
+    typedef std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> MinQueue;
+}
+
+ReservationTable::ReservationTable() : cellCount_(0), vertices_(), edges_() {}
+
+long long ReservationTable::vertexKey(int cell, int time) const {
+    return static_cast<long long>(time) * cellCount_ + cell;
+}
+
+long long ReservationTable::edgeKey(int from, int to, int time) const {
+    // A move can only reach one of four neighbours, so the target is stored
+    // as its offset from the source cell.
+    int dir = to - from;
+    int slot = dir == 1 ? 0 : (dir == -1 ? 1 : (dir > 0 ? 2 : 3));
+    return vertexKey(from, time) * 4 + slot;
+}
+
+void ReservationTable::reset(int cellCount) {
+    cellCount_ = cellCount;
+    clear();
+}
+
+void ReservationTable::clear() {
+    vertices_.clear();
+    edges_.clear();
+}
+
+void ReservationTable::reserveVertex(int cell, int time) {
+    vertices_.insert(vertexKey(cell, time));
+}
+
+void ReservationTable::releaseVertex(int cell, int time) {
+    vertices_.erase(vertexKey(cell, time));
+}
+
+void ReservationTable::reserveEdge(int from, int to, int time) {
+    if (from != to) {
+        edges_.insert(edgeKey(from, to, time));
+    }
+}
+
+bool ReservationTable::isVertexReserved(int cell, int time) const {
+    return vertices_.count(vertexKey(cell, time)) != 0;
+}
+
+// Moving from -> to between time and time + 1 collides with an agent that
+// already holds the target cell at time + 1, or with one swapping through
+// the same edge in the opposite direction.
+bool ReservationTable::isMoveBlocked(int from, int to, int time) const {
+    if (isVertexReserved(to, time + 1)) {
+        return true;
+    }
+    return from != to && edges_.count(edgeKey(to, from, time)) != 0;
+}
+
+std::size_t ReservationTable::size() const {
+    return vertices_.size() + edges_.size();
+}
+
+CooperativePlanner::CooperativePlanner()
+    : maze_(nullptr),
+      window_(16),
+      replanInterval_(8),
+      maxTimeSteps_(10000),
+      time_(0),
+      cycle_(0),
+      status_(SolveStatus::Unreachable),
+      heuristicMemory_(256u << 20),
+      heuristicBuilds_(0) {}
+
+void CooperativePlanner::setWindow(int window) {
+    window_ = std::max(1, window);
+    replanInterval_ = std::min(replanInterval_, window_);
+}
+
+void CooperativePlanner::setReplanInterval(int steps) {
+    replanInterval_ = std::max(1, std::min(steps, window_));
+}
+
+void CooperativePlanner::setMaxTimeSteps(int steps) {
+    maxTimeSteps_ = steps;
+}
+
+void CooperativePlanner::setHeuristicMemory(std::size_t bytes) {
+    heuristicMemory_ = bytes;
+    while (maze_ && heuristics_.size() > maxHeuristics()) {
+        heuristics_.erase(heuristicOrder_.back());
+        heuristicOrder_.pop_back();
+    }
+}
+
+int CooperativePlanner::getWindow() const {
+    return window_;
+}
+
+int CooperativePlanner::getReplanInterval() const {
+    return replanInterval_;
+}
+
+int CooperativePlanner::getMaxTimeSteps() const {
+    return maxTimeSteps_;
+}
+
+std::size_t CooperativePlanner::getHeuristicMemory() const {
+    return heuristicMemory_;
+}
+
+long long CooperativePlanner::getHeuristicBuilds() const {
+    return heuristicBuilds_;
+}
+
+int CooperativePlanner::toCell(const Point& p) const {
+    return p.getY() * maze_->getWidth() + p.getX();
+}
+
+Point CooperativePlanner::toPoint(int cell) const {
+    return Point(cell % maze_->getWidth(), cell / maze_->getWidth());
+}
+
+// At least one field is always kept, however small the budget.
+std::size_t CooperativePlanner::maxHeuristics() const {
+    const std::size_t cells = static_cast<std::size_t>(maze_->getWidth()) * maze_->getHeight();
+    const std::size_t fieldBytes = std::max<std::size_t>(1, cells * (sizeof(double) + 1));
+    return std::max<std::size_t>(1, heuristicMemory_ / fieldBytes);
+}
+
+// Builds a goal's field on first use and evicts the least recently used
+// one past the memory budget. Agents sharing a goal share one field.
+const FlowField& CooperativePlanner::heuristicFor(int goalCell) {
+    auto it = heuristics_.find(goalCell);
+    if (it != heuristics_.end()) {
+        heuristicOrder_.splice(heuristicOrder_.begin(), heuristicOrder_, it->second.use);
+        return it->second.field;
+    }
+
+    if (heuristics_.size() >= maxHeuristics()) {
+        heuristics_.erase(heuristicOrder_.back());
+        heuristicOrder_.pop_back();
+    }
+    heuristicOrder_.push_front(goalCell);
+    it = heuristics_.emplace(goalCell, CachedField()).first;
+    it->second.use = heuristicOrder_.begin();
+    it->second.field.build(*maze_, toPoint(goalCell));
+    heuristicBuilds_++;
+    return it->second.field;
+}
+
+bool CooperativePlanner::begin(const Maze& maze, const std::vector<AgentTask>& tasks) {
+    maze_ = &maze;
+    time_ = 0;
+    cycle_ = 0;
+    status_ = SolveStatus::Unreachable;
+    tasks_ = tasks;
+    heuristics_.clear();
+    heuristicOrder_.clear();
+    heuristicBuilds_ = 0;
+    plans_.assign(tasks.size(), AgentPlan());
+    positions_.assign(tasks.size(), -1);
+    goals_.assign(tasks.size(), -1);
+    windowPaths_.assign(tasks.size(), std::vector<int>());
+    reservations_.reset(maze.getWidth() * maze.getHeight());
+
+    std::unordered_set<int> occupied;
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        if (!maze.isWalkable(tasks[i].start) || !maze.isWalkable(tasks[i].goal)) {
+            return false;
+        }
+        positions_[i] = toCell(tasks[i].start);
+        goals_[i] = toCell(tasks[i].goal);
+        if (!occupied.insert(positions_[i]).second) {
+            return false;
+        }
+        plans_[i].path.push_back(tasks[i].start);
+    }
+    return true;
+}
+
+// Space-time A* over (cell, offset) for one window. Moving into a cell
+// costs the cell's terrain cost; waiting costs one step unless the agent is
+// already on its goal. The flow field's exact cost-to-goal closes the
+// window, so the best windowed plan still heads the right way.
+bool CooperativePlanner::planWindow(int agent, const FlowField& field, SolveBudget& budget, bool& stopped) {
+    const std::size_t a = static_cast<std::size_t>(agent);
+    const int width = maze_->getWidth();
+    const int goal = goals_[a];
+
+    nodes_.clear();
+    nodeIndex_.clear();
+    MinQueue open;
+
+    auto keyOf = [this](int cell, int offset) {
+        return static_cast<long long>(cell) * (window_ + 1) + offset;
+    };
+    auto h = [&](int cell) {
+        double d = field.getDistance(toPoint(cell));
+        return d == kInfinity ? 0.0 : d;
+    };
+
+    SearchNode root;
+    root.cell = positions_[a];
+    root.offset = 0;
+    root.g = 0.0;
+    root.parent = -1;
+    nodes_.push_back(root);
+    nodeIndex_[keyOf(root.cell, 0)] = 0;
+    open.push(QueueItem(h(root.cell), 0));
+
+    int terminal = -1;
+    int deepest = 0;
+    while (!open.empty()) {
+        QueueItem top = open.top();
+        open.pop();
+
+        const SearchNode current = nodes_[static_cast<std::size_t>(top.second)];
+        if (top.first > current.g + h(current.cell)) continue;
+
+        if (!budget.consume()) {
+            stopped = true;
+            return false;
+        }
+        plans_[a].nodesExplored++;
+
+        if (current.offset > nodes_[static_cast<std::size_t>(deepest)].offset) {
+            deepest = top.second;
+        }
+        if (current.offset == window_) {
+            terminal = top.second;
+            break;
+        }
+
+        const int t = time_ + current.offset;
+        const int cx = current.cell % width;
+        const int cy = current.cell / width;
+        for (int k = 0; k < 5; k++) {
+            Point next(cx + kDx[k], cy + kDy[k]);
+            if (!maze_->isWalkable(next)) continue;
+
+            int nextCell = toCell(next);
+            if (reservations_.isMoveBlocked(current.cell, nextCell, t)) continue;
+
+            double step;
+            if (k == 0) {
+                step = current.cell == goal ? 0.0 : kWaitCost;
+            } else {
+                step = maze_->getCellCost(next);
+            }
+
+            double g = current.g + step;
+            long long key = keyOf(nextCell, current.offset + 1);
+            auto found = nodeIndex_.find(key);
+            if (found != nodeIndex_.end() && nodes_[static_cast<std::size_t>(found->second)].g <= g) {
+                continue;
+            }
+
+            SearchNode child;
+            child.cell = nextCell;
+            child.offset = current.offset + 1;
+            child.g = g;
+            child.parent = top.second;
+
+            int id;
+            if (found != nodeIndex_.end()) {
+                id = found->second;
+                nodes_[static_cast<std::size_t>(id)] = child;
+            } else {
+                id = static_cast<int>(nodes_.size());
+                nodes_.push_back(child);
+                nodeIndex_[key] = id;
+            }
+            open.push(QueueItem(g + h(nextCell), id));
+        }
+    }
+
+    // Boxed in for the full window: keep the deepest conflict-free prefix.
+    // The cycle only commits as many steps as every agent could plan.
+    std::vector<int>& path = windowPaths_[a];
+    path.clear();
+    for (int id = terminal != -1 ? terminal : deepest; id != -1; id = nodes_[static_cast<std::size_t>(id)].parent) {
+        path.push_back(nodes_[static_cast<std::size_t>(id)].cell);
+    }
+    std::reverse(path.begin(), path.end());
+    return terminal != -1;
+}
+
+void CooperativePlanner::reservePath(const std::vector<int>& path) {
+    for (std::size_t i = 0; i < path.size(); i++) {
+        int t = time_ + static_cast<int>(i);
+        reservations_.reserveVertex(path[i], t);
+        if (i + 1 < path.size()) {
+            reservations_.reserveEdge(path[i], path[i + 1], t);
+        }
+    }
+}
+
+bool CooperativePlanner::allAtGoal() const {
+    for (std::size_t i = 0; i < positions_.size(); i++) {
+        if (positions_[i] != goals_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CooperativePlanner::planCycle(const SolveOptions& options) {
+    if (maze_ == nullptr) {
+        return false;
+    }
+    if (allAtGoal()) {
+        status_ = SolveStatus::Found;
+        return false;
+    }
+    if (time_ >= maxTimeSteps_) {
+        status_ = SolveStatus::BudgetExceeded;
+        return false;
+    }
+    // Agents share one maze; a single query's corridor does not apply.
+    if (options.hasAllowedCells()) {
+        status_ = SolveStatus::Unsupported;
+        return false;
+    }
+
+    SolveBudget budget(options);
+    const std::size_t agents = tasks_.size();
+
+    // Every agent holds its current cell for the first step until it is
+    // planned itself, so waiting is always possible and each window is at
+    // least one step deep.
+    reservations_.clear();
+    for (std::size_t i = 0; i < agents; i++) {
+        reservations_.reserveVertex(positions_[i], time_);
+        reservations_.reserveVertex(positions_[i], time_ + 1);
+    }
+
+    // Rotating the priority order each cycle keeps a low-priority agent
+    // from being starved by the same neighbours forever.
+    for (std::size_t n = 0; n < agents; n++) {
+        std::size_t i = (n + static_cast<std::size_t>(cycle_)) % agents;
+        AgentPlan& plan = plans_[i];
+
+        reservations_.releaseVertex(positions_[i], time_ + 1);
+
+        // Fetched before the clock starts, so replanning time covers only
+        // the windowed search.
+        const FlowField& field = heuristicFor(goals_[i]);
+
+        auto started = std::chrono::steady_clock::now();
+        bool stopped = false;
+        bool planned = planWindow(static_cast<int>(i), field, budget, stopped);
+        long long micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started).count();
+
+        if (stopped) {
+            status_ = budget.getStopStatus();
+            return false;
+        }
+
+        plan.replans++;
+        plan.totalReplanMicros += micros;
+        plan.maxReplanMicros = std::max(plan.maxReplanMicros, micros);
+        if (!planned) {
+            plan.searchFailures++;
+        }
+        reservePath(windowPaths_[i]);
+    }
+
+    int steps = std::min(replanInterval_, maxTimeSteps_ - time_);
+    for (std::size_t i = 0; i < agents; i++) {
+        steps = std::min(steps, static_cast<int>(windowPaths_[i].size()) - 1);
+    }
+
+    for (std::size_t i = 0; i < agents; i++) {
+        const std::vector<int>& path = windowPaths_[i];
+        AgentPlan& plan = plans_[i];
+        for (int s = 1; s <= steps; s++) {
+            int cell = path[static_cast<std::size_t>(s)];
+            plan.path.push_back(toPoint(cell));
+            if (cell != goals_[i]) {
+                plan.arrivalTime = -1;
+            } else if (plan.arrivalTime == -1) {
+                plan.arrivalTime = time_ + s;
+            }
+        }
+        positions_[i] = toCell(plan.path.back());
+    }
+
+    time_ += steps;
+    cycle_++;
+
+    if (allAtGoal()) {
+        status_ = SolveStatus::Found;
+    } else if (time_ >= maxTimeSteps_) {
+        status_ = SolveStatus::BudgetExceeded;
+    }
+    return true;
+}
+
+SolveStatus CooperativePlanner::solve(const Maze& maze, const std::vector<AgentTask>& tasks,
+                                      const SolveOptions& options) {
+    if (!begin(maze, tasks)) {
+        return status_;
+    }
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        if (!maze.areConnected(tasks[i].start, tasks[i].goal)) {
+            status_ = SolveStatus::Unreachable;
+            return status_;
+        }
+    }
+
+    while (planCycle(options)) {
+    }
+    return status_;
+}
+
+bool CooperativePlanner::isComplete() const {
+    return maze_ != nullptr && allAtGoal();
+}
+
+SolveStatus CooperativePlanner::getStatus() const {
+    return status_;
+}
+
+int CooperativePlanner::getTime() const {
+    return time_;
+}
+
+const std::vector<AgentPlan>& CooperativePlanner::getPlans() const {
+    return plans_;
+}
+
+int CooperativePlanner::countConflicts() const {
+    int conflicts = 0;
+    std::size_t horizon = 0;
+    for (const auto& plan : plans_) {
+        horizon = std::max(horizon, plan.path.size());
+    }
+
+    std::unordered_map<long long, std::size_t> occupied;
+    for (std::size_t t = 0; t < horizon; t++) {
+        occupied.clear();
+        for (std::size_t i = 0; i < plans_.size(); i++) {
+            const std::vector<Point>& path = plans_[i].path;
+            if (path.empty()) continue;
+            Point here = path[std::min(t, path.size() - 1)];
+            long long key = toCell(here);
+            auto inserted = occupied.emplace(key, i);
+            if (!inserted.second) {
+                conflicts++;
+            }
+        }
+        if (t + 1 >= horizon) break;
+        for (std::size_t i = 0; i < plans_.size(); i++) {
+            const std::vector<Point>& a = plans_[i].path;
+            if (a.empty()) continue;
+            Point from = a[std::min(t, a.size() - 1)];
+            Point to = a[std::min(t + 1, a.size() - 1)];
+            if (from == to) continue;
+            auto other = occupied.find(toCell(to));
+            if (other == occupied.end()) continue;
+            const std::vector<Point>& b = plans_[other->second].path;
+            if (other->second > i && b[std::min(t + 1, b.size() - 1)] == from) {
+                conflicts++;
+            }
+        }
+    }
+    return conflicts;
+}
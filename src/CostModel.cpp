@@ -0,0 +1,110 @@
+#include "CostModel.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+CostModel::CostModel() : minimumCost_(1.0) {
+    for (int i = 0; i < 256; i++) {
+        costs_[i] = 1.0;
+    }
+    costs_[static_cast<unsigned char>('#')] = impassable();
+    costs_[static_cast<unsigned char>('~')] = 2.0;
+    costs_[static_cast<unsigned char>('^')] = 3.0;
+    updateMinimumCost();
+}
+
+std::shared_ptr<const CostModel> CostModel::standard() {
+    static const std::shared_ptr<const CostModel> model = std::make_shared<CostModel>();
+    return model;
+}
+
+void CostModel::updateMinimumCost() {
+    minimumCost_ = impassable();
+    for (int i = 0; i < 256; i++) {
+        if (costs_[i] < minimumCost_) {
+            minimumCost_ = costs_[i];
+        }
+    }
+}
+
+const double* CostModel::getTable() const {
+    return costs_;
+}
+
+double CostModel::getMinimumCost() const {
+    return minimumCost_;
+}
+
+double CostModel::getMaximumCost() const {
+    double maximum = 0.0;
+    for (int i = 0; i < 256; i++) {
+        if (costs_[i] != impassable() && costs_[i] > maximum) {
+            maximum = costs_[i];
+        }
+    }
+    return maximum;
+}
+
+bool CostModel::hasIntegerCosts() const {
+    for (int i = 0; i < 256; i++) {
+        if (costs_[i] != impassable() && costs_[i] != std::floor(costs_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CostModel::setCost(char cell, double cost) {
+    if (!(cost > 0.0)) {
+        return false;
+    }
+    costs_[static_cast<unsigned char>(cell)] = cost;
+    updateMinimumCost();
+    return true;
+}
+
+void CostModel::setImpassable(char cell) {
+    costs_[static_cast<unsigned char>(cell)] = impassable();
+    updateMinimumCost();
+}
+
+// Each non-empty line is "<cell> <cost>" or "<cell> impassable"; lines
+// starting with "//" are comments. Entries not mentioned keep their value.
+// The model is only changed if the whole file parses.
+bool CostModel::loadFromFile(const char* filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    CostModel staged(*this);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string cell;
+        std::string value;
+
+        if (!(fields >> cell) || cell.compare(0, 2, "//") == 0) {
+            continue;
+        }
+        if (cell.size() != 1 || !(fields >> value)) {
+            return false;
+        }
+
+        if (value == "impassable") {
+            staged.setImpassable(cell[0]);
+            continue;
+        }
+
+        std::istringstream number(value);
+        double cost = 0.0;
+        if (!(number >> cost) || !staged.setCost(cell[0], cost)) {
+            return false;
+        }
+    }
+
+    *this = staged;
+    return true;
+}
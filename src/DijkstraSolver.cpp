@@ -97,13 +97,7 @@ int DijkstraSolver::pointToIndex(const Point& p, int width) const {
 }
 
 double DijkstraSolver::getCellCost(const Maze& maze, const Point& p) const {
-    char cell = maze.getCellAt(p);
-
-    if (cell == '.' || cell == 'S' || cell == 'G') return 1.0;
-    if (cell == '~') return 2.0;
-    if (cell == '^') return 3.0;
-
-    return 1.0;
+    return maze.getCellCost(p);
 }
 
 Path DijkstraSolver::reconstructPath(const Point& start, const Point& goal, int width) const {
@@ -140,21 +134,26 @@ Path DijkstraSolver::reconstructPath(const Point& start, const Point& goal, int
     return path;
 }
 
-Path DijkstraSolver::solve(const Maze& maze) {
+SolveResult DijkstraSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
     Point start = maze.getStart();
     Point goal = maze.getGoal();
     int width = maze.getWidth();
     int height = maze.getHeight();
 
+    if (!maze.areConnected(start, goal)) {
+        parent_.clear();
+        distance_.clear();
+        visited_.clear();
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
     parent_.assign(static_cast<std::size_t>(width * height), Point(-1, -1));
     distance_.assign(static_cast<std::size_t>(width * height), std::numeric_limits<double>::infinity());
     visited_.assign(static_cast<std::size_t>(width * height), false);
 
+    SolveBudget budget(options);
     PriorityQueue pq;
     int startIdx = pointToIndex(start, width);
-    if (startIdx < 0 || startIdx >= static_cast<int>(distance_.size())) {
-        return Path();
-    }
 
     distance_[static_cast<std::size_t>(startIdx)] = 0.0;
     pq.push(PQNode(start, 0.0));
@@ -171,6 +170,10 @@ Path DijkstraSolver::solve(const Maze& maze) {
         }
 
         if (visited_[static_cast<std::size_t>(currentIdx)]) continue;
+
+        if (!budget.consume()) {
+            return SolveResult(budget.getStopStatus());
+        }
         visited_[static_cast<std::size_t>(currentIdx)] = true;
 
         if (currentPoint == goal) {
@@ -186,7 +189,8 @@ Path DijkstraSolver::solve(const Maze& maze) {
             Point neighbor = neighbors[i];
             int neighborIdx = pointToIndex(neighbor, width);
 
-            if (neighborIdx < 0 || neighborIdx >= static_cast<int>(visited_.size())) {
+            if (neighborIdx < 0 || neighborIdx >= static_cast<int>(visited_.size()) ||
+                !options.isCellAllowed(neighborIdx)) {
                 continue;
             }
 
@@ -203,10 +207,10 @@ Path DijkstraSolver::solve(const Maze& maze) {
     }
 
     if (found) {
-        return reconstructPath(start, goal, width);
+        return SolveResult(SolveStatus::Found, reconstructPath(start, goal, width));
     }
 
-    return Path();
+    return SolveResult(SolveStatus::Unreachable);
 }
 
 int DijkstraSolver::getNodesExplored() const {
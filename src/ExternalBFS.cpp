@@ -0,0 +1,554 @@
+#include "ExternalBFS.h"
+#include "Exceptions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace {
+    const std::size_t kIoBufferEntries = 1 << 14;
+    const std::size_t kStreamBufferBytes = 1 << 16;
+
+    struct IoCounters {
+        long long bytesRead = 0;
+        long long bytesWritten = 0;
+    };
+
+    class TempFiles {
+    private:
+        std::vector<std::string> paths_;
+
+    public:
+        ~TempFiles() {
+            for (const auto& path : paths_) {
+                std::remove(path.c_str());
+            }
+        }
+
+        std::string track(const std::string& path) {
+            paths_.push_back(path);
+            return path;
+        }
+
+        void release(const std::string& path) {
+            std::remove(path.c_str());
+            paths_.erase(std::remove(paths_.begin(), paths_.end(), path), paths_.end());
+        }
+    };
+
+    class CellStream {
+    private:
+        std::FILE* file_;
+        std::vector<char> buffer_;
+        std::size_t pos_;
+        std::size_t len_;
+        long long offset_;
+        IoCounters& io_;
+
+        bool refill() {
+            len_ = std::fread(buffer_.data(), 1, buffer_.size(), file_);
+            pos_ = 0;
+            io_.bytesRead += static_cast<long long>(len_);
+            return len_ > 0;
+        }
+
+    public:
+        CellStream(const char* filename, IoCounters& io)
+            : file_(std::fopen(filename, "rb")), buffer_(kStreamBufferBytes), pos_(0), len_(0), offset_(0), io_(io) {}
+
+        ~CellStream() {
+            if (file_) std::fclose(file_);
+        }
+
+        bool isOpen() const {
+            return file_ != nullptr;
+        }
+
+        long long tell() const {
+            return offset_;
+        }
+
+        void seek(long long offset) {
+            fseeko(file_, static_cast<off_t>(offset), SEEK_SET);
+            offset_ = offset;
+            pos_ = 0;
+            len_ = 0;
+        }
+
+        int nextChar() {
+            if (pos_ >= len_ && !refill()) {
+                return -1;
+            }
+            offset_++;
+            return static_cast<unsigned char>(buffer_[pos_++]);
+        }
+
+        int nextNonSpace() {
+            int c = nextChar();
+            while (c != -1 && std::isspace(c)) {
+                c = nextChar();
+            }
+            return c;
+        }
+
+        bool readInt(int& value) {
+            int c = nextNonSpace();
+            if (c == -1 || !std::isdigit(c)) {
+                return false;
+            }
+            long long result = 0;
+            while (c != -1 && std::isdigit(c)) {
+                result = result * 10 + (c - '0');
+                c = nextChar();
+            }
+            value = static_cast<int>(result);
+            return true;
+        }
+
+        bool readRow(std::vector<char>& row, int width) {
+            row.resize(static_cast<std::size_t>(width));
+            for (int x = 0; x < width; x++) {
+                int c = nextNonSpace();
+                if (c == -1) return false;
+                row[static_cast<std::size_t>(x)] = static_cast<char>(c);
+            }
+            return true;
+        }
+
+        // Leaves the stream right before the first cell of the next row so
+        // tell() reports a seekable row boundary.
+        void skipSpaces() {
+            while (true) {
+                if (pos_ >= len_ && !refill()) return;
+                if (!std::isspace(static_cast<unsigned char>(buffer_[pos_]))) return;
+                pos_++;
+                offset_++;
+            }
+        }
+    };
+
+    class RunWriter {
+    private:
+        std::FILE* file_;
+        std::vector<long long> buffer_;
+        long long count_;
+        IoCounters& io_;
+
+        void flush() {
+            if (buffer_.empty()) return;
+            std::fwrite(buffer_.data(), sizeof(long long), buffer_.size(), file_);
+            io_.bytesWritten += static_cast<long long>(buffer_.size() * sizeof(long long));
+            buffer_.clear();
+        }
+
+    public:
+        RunWriter(const std::string& path, IoCounters& io)
+            : file_(std::fopen(path.c_str(), "wb")), buffer_(), count_(0), io_(io) {
+            if (!file_) {
+                throw MazeException("Cannot create external BFS run file: " + path);
+            }
+            buffer_.reserve(kIoBufferEntries);
+        }
+
+        ~RunWriter() {
+            close();
+        }
+
+        void write(long long value) {
+            buffer_.push_back(value);
+            count_++;
+            if (buffer_.size() >= kIoBufferEntries) flush();
+        }
+
+        void close() {
+            if (file_) {
+                flush();
+                std::fclose(file_);
+                file_ = nullptr;
+            }
+        }
+
+        long long getCount() const {
+            return count_;
+        }
+    };
+
+    class RunReader {
+    private:
+        std::FILE* file_;
+        std::vector<long long> buffer_;
+        std::size_t pos_;
+        std::size_t len_;
+        IoCounters& io_;
+
+    public:
+        RunReader(const std::string& path, IoCounters& io)
+            : file_(path.empty() ? nullptr : std::fopen(path.c_str(), "rb")),
+              buffer_(kIoBufferEntries), pos_(0), len_(0), io_(io) {}
+
+        ~RunReader() {
+            if (file_) std::fclose(file_);
+        }
+
+        bool next(long long& value) {
+            if (pos_ >= len_) {
+                if (!file_) return false;
+                len_ = std::fread(buffer_.data(), sizeof(long long), buffer_.size(), file_);
+                pos_ = 0;
+                io_.bytesRead += static_cast<long long>(len_ * sizeof(long long));
+                if (len_ == 0) return false;
+            }
+            value = buffer_[pos_++];
+            return true;
+        }
+    };
+
+    class SortedCursor {
+    private:
+        RunReader reader_;
+        long long current_;
+        bool valid_;
+
+    public:
+        SortedCursor(const std::string& path, IoCounters& io) : reader_(path, io), current_(0), valid_(false) {
+            valid_ = reader_.next(current_);
+        }
+
+        // Advances past every value below target and reports whether target
+        // itself is present.
+        bool contains(long long target) {
+            while (valid_ && current_ < target) {
+                valid_ = reader_.next(current_);
+            }
+            return valid_ && current_ == target;
+        }
+    };
+
+    class CandidateSorter {
+    private:
+        std::vector<long long> buffer_;
+        std::vector<std::string> runs_;
+        std::size_t budget_;
+        std::function<std::string()> makePath_;
+        TempFiles& temps_;
+        IoCounters& io_;
+
+        void sortBuffer() {
+            std::sort(buffer_.begin(), buffer_.end());
+            buffer_.erase(std::unique(buffer_.begin(), buffer_.end()), buffer_.end());
+        }
+
+        void spill() {
+            sortBuffer();
+            std::string path = temps_.track(makePath_());
+            RunWriter writer(path, io_);
+            for (long long value : buffer_) writer.write(value);
+            runs_.push_back(path);
+            buffer_.clear();
+        }
+
+    public:
+        CandidateSorter(std::size_t budget, std::function<std::string()> makePath, TempFiles& temps, IoCounters& io)
+            : buffer_(), runs_(), budget_(std::max<std::size_t>(budget, 1)), makePath_(makePath), temps_(temps), io_(io) {}
+
+        void add(long long value) {
+            buffer_.push_back(value);
+            if (buffer_.size() >= budget_) spill();
+        }
+
+        int getRunCount() const {
+            return static_cast<int>(runs_.size());
+        }
+
+        // Streams the sorted, de-duplicated union of every spilled run and
+        // the in-memory tail to the visitor.
+        template <typename Visitor>
+        void mergeInto(Visitor visit) {
+            sortBuffer();
+
+            typedef std::pair<long long, std::size_t> HeapItem;
+            std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>> heap;
+            std::vector<std::unique_ptr<RunReader>> readers;
+            readers.reserve(runs_.size());
+
+            for (std::size_t i = 0; i < runs_.size(); i++) {
+                readers.emplace_back(new RunReader(runs_[i], io_));
+                long long value;
+                if (readers.back()->next(value)) heap.push(HeapItem(value, i));
+            }
+
+            std::size_t memoryPos = 0;
+            const std::size_t memorySource = runs_.size();
+            if (memoryPos < buffer_.size()) heap.push(HeapItem(buffer_[memoryPos++], memorySource));
+
+            bool hasLast = false;
+            long long last = 0;
+            while (!heap.empty()) {
+                HeapItem top = heap.top();
+                heap.pop();
+
+                if (!hasLast || top.first != last) {
+                    visit(top.first);
+                    last = top.first;
+                    hasLast = true;
+                }
+
+                long long value;
+                if (top.second == memorySource) {
+                    if (memoryPos < buffer_.size()) heap.push(HeapItem(buffer_[memoryPos++], memorySource));
+                } else if (readers[top.second]->next(value)) {
+                    heap.push(HeapItem(value, top.second));
+                }
+            }
+
+            readers.clear();
+            for (const auto& run : runs_) temps_.release(run);
+            runs_.clear();
+            buffer_.clear();
+        }
+    };
+}
+
+ExternalBFS::ExternalBFS()
+    : tempDirectory_("/tmp"), memoryBudget_(1 << 20), bandRows_(64), recordPath_(false), costModel_(CostModel::standard()), stats_() {}
+
+std::string ExternalBFS::makeTempPath() const {
+    static std::atomic<unsigned> serial(0);
+    return tempDirectory_ + "/maze_ebfs_" + std::to_string(static_cast<long long>(getpid())) + "_" +
+           std::to_string(static_cast<unsigned long long>(serial++)) + ".run";
+}
+
+void ExternalBFS::setTempDirectory(const std::string& directory) {
+    tempDirectory_ = directory;
+}
+
+void ExternalBFS::setMemoryBudget(std::size_t entries) {
+    memoryBudget_ = entries;
+}
+
+void ExternalBFS::setBandRows(int rows) {
+    bandRows_ = std::max(1, rows);
+}
+
+void ExternalBFS::setRecordPath(bool record) {
+    recordPath_ = record;
+}
+
+void ExternalBFS::setCostModel(const std::shared_ptr<const CostModel>& model) {
+    costModel_ = model ? model : CostModel::standard();
+}
+
+SolveResult ExternalBFS::solveFile(const char* filename, const SolveOptions& options) {
+    stats_ = ExternalBFSStats();
+    // An allowed-cells mask is an in-memory W*H array, exactly the state
+    // this solver keeps on disk instead.
+    if (options.hasAllowedCells()) {
+        return SolveResult(SolveStatus::Unsupported);
+    }
+    IoCounters io;
+    TempFiles temps;
+
+    CellStream maze(filename, io);
+    if (!maze.isOpen()) {
+        throw MazeException(std::string("Failed to open maze file: ") + filename);
+    }
+
+    int width = 0;
+    int height = 0;
+    if (!maze.readInt(width) || !maze.readInt(height) || width <= 0 || height <= 0) {
+        throw MazeException(std::string("Invalid maze header in file: ") + filename);
+    }
+
+    // One sequential pass locates S and G and remembers where each band of
+    // rows starts, so later levels can seek straight to the band they need.
+    std::vector<long long> bandOffsets;
+    std::vector<char> row;
+    long long start = -1;
+    long long goal = -1;
+
+    for (int y = 0; y < height; y++) {
+        if (y % bandRows_ == 0) {
+            maze.skipSpaces();
+            bandOffsets.push_back(maze.tell());
+        }
+        if (!maze.readRow(row, width)) {
+            throw MazeException(std::string("Truncated maze file: ") + filename);
+        }
+        for (int x = 0; x < width; x++) {
+            long long cell = static_cast<long long>(y) * width + x;
+            if (row[static_cast<std::size_t>(x)] == 'S') start = cell;
+            else if (row[static_cast<std::size_t>(x)] == 'G') goal = cell;
+        }
+    }
+
+    if (start < 0 || goal < 0) {
+        throw MazeException(std::string("Maze file has no start or goal: ") + filename);
+    }
+
+    auto toPoint = [width](long long cell) {
+        return Point(static_cast<int>(cell % width), static_cast<int>(cell / width));
+    };
+    auto finishStats = [this, &io]() {
+        stats_.bytesRead = io.bytesRead;
+        stats_.bytesWritten = io.bytesWritten;
+    };
+
+    std::vector<std::string> levels;
+    levels.push_back(temps.track(makeTempPath()));
+    {
+        RunWriter writer(levels.back(), io);
+        writer.write(start);
+    }
+    stats_.levels = 1;
+    stats_.cellsVisited = 1;
+    stats_.largestLevel = 1;
+
+    // Steps are unweighted here; the model only decides which bytes are walls.
+    bool passable[256];
+    for (int c = 0; c < 256; c++) {
+        passable[c] = costModel_->isPassable(static_cast<char>(c));
+    }
+    auto open = [&passable](char cell) {
+        return passable[static_cast<unsigned char>(cell)];
+    };
+
+    SolveBudget budget(options);
+    std::vector<std::vector<char>> window(3, std::vector<char>(static_cast<std::size_t>(width)));
+    std::string previous;
+    long long length = (start == goal) ? 0 : -1;
+
+    for (int level = 0; length < 0; level++) {
+        const std::string current = levels.back();
+        CandidateSorter sorter(memoryBudget_, [this]() { return makeTempPath(); }, temps, io);
+
+        RunReader frontier(current, io);
+        int nextRow = -1;
+        long long cell;
+        while (frontier.next(cell)) {
+            if (!budget.consume()) {
+                finishStats();
+                return SolveResult(budget.getStopStatus());
+            }
+
+            int y = static_cast<int>(cell / width);
+            int x = static_cast<int>(cell % width);
+            int firstRow = std::max(0, y - 1);
+            int lastRow = std::min(height - 1, y + 1);
+
+            if (nextRow < firstRow) {
+                int band = firstRow / bandRows_;
+                if (nextRow < band * bandRows_) {
+                    maze.seek(bandOffsets[static_cast<std::size_t>(band)]);
+                    nextRow = band * bandRows_;
+                }
+            }
+            while (nextRow <= lastRow) {
+                maze.readRow(window[static_cast<std::size_t>(nextRow % 3)], width);
+                nextRow++;
+            }
+
+            const std::vector<char>& here = window[static_cast<std::size_t>(y % 3)];
+            if (y > 0 && open(window[static_cast<std::size_t>((y - 1) % 3)][static_cast<std::size_t>(x)])) {
+                sorter.add(cell - width);
+            }
+            if (y < height - 1 && open(window[static_cast<std::size_t>((y + 1) % 3)][static_cast<std::size_t>(x)])) {
+                sorter.add(cell + width);
+            }
+            if (x > 0 && open(here[static_cast<std::size_t>(x - 1)])) {
+                sorter.add(cell - 1);
+            }
+            if (x < width - 1 && open(here[static_cast<std::size_t>(x + 1)])) {
+                sorter.add(cell + 1);
+            }
+        }
+
+        // Undirected BFS only ever rediscovers cells from the two most
+        // recent levels, so those are the only files to subtract.
+        stats_.runFiles += sorter.getRunCount();
+        std::string nextLevel = temps.track(makeTempPath());
+        bool reachedGoal = false;
+        long long count = 0;
+        {
+            RunWriter writer(nextLevel, io);
+            SortedCursor inCurrent(current, io);
+            SortedCursor inPrevious(previous, io);
+            sorter.mergeInto([&](long long candidate) {
+                if (inCurrent.contains(candidate) || inPrevious.contains(candidate)) {
+                    return;
+                }
+                writer.write(candidate);
+                if (candidate == goal) reachedGoal = true;
+            });
+            count = writer.getCount();
+        }
+
+        if (!recordPath_ && !previous.empty()) {
+            temps.release(previous);
+        }
+        previous = current;
+        levels.push_back(nextLevel);
+
+        stats_.levels++;
+        stats_.cellsVisited += count;
+        stats_.largestLevel = std::max(stats_.largestLevel, count);
+
+        if (reachedGoal) {
+            length = level + 1;
+        } else if (count == 0) {
+            finishStats();
+            return SolveResult(SolveStatus::Unreachable);
+        }
+    }
+
+    stats_.pathLength = length;
+
+    Path path;
+    if (recordPath_ || length == 0) {
+        std::vector<Point> reverse;
+        long long current = goal;
+        reverse.push_back(toPoint(goal));
+
+        for (long long level = length - 1; level >= 0; level--) {
+            RunReader reader(levels[static_cast<std::size_t>(level)], io);
+            long long candidate;
+            while (reader.next(candidate)) {
+                bool adjacent = candidate == current - width || candidate == current + width ||
+                                (candidate == current - 1 && current % width != 0) ||
+                                (candidate == current + 1 && candidate % width != 0);
+                if (adjacent) {
+                    current = candidate;
+                    break;
+                }
+            }
+            reverse.push_back(toPoint(current));
+        }
+
+        for (auto it = reverse.rbegin(); it != reverse.rend(); ++it) {
+            path.addPoint(*it);
+        }
+    }
+    path.setCost(static_cast<double>(length));
+
+    finishStats();
+    return SolveResult(SolveStatus::Found, path);
+}
+
+const CostModel& ExternalBFS::getCostModel() const {
+    return *costModel_;
+}
+
+const ExternalBFSStats& ExternalBFS::getStats() const {
+    return stats_;
+}
+
+long long ExternalBFS::getPathLength() const {
+    return stats_.pathLength;
+}
@@ -0,0 +1,258 @@
+#include "FlowField.h"
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace {
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+    const double kInfinity = std::numeric_limits<double>::infinity();
+    const double kEpsilon = 1e-9;
+
+    typedef std::pair<double, int> QueueItem;
+    typedef std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> MinQueue;
+}
+
+FlowField::FlowField() : width_(0), height_(0), goal_(-1, -1), built_(false) {}
+
+int FlowField::index(int x, int y) const {
+    return y * width_ + x;
+}
+
+bool FlowField::inBounds(int x, int y) const {
+    return x >= 0 && x < width_ && y >= 0 && y < height_;
+}
+
+int FlowField::getDirectionAt(int cell) const {
+    return (directions_[static_cast<std::size_t>(cell >> 2)] >> ((cell & 3) * 2)) & 3;
+}
+
+void FlowField::setDirectionAt(int cell, int direction) {
+    unsigned char& packed = directions_[static_cast<std::size_t>(cell >> 2)];
+    int shift = (cell & 3) * 2;
+    packed = static_cast<unsigned char>((packed & ~(3 << shift)) | (direction << shift));
+}
+
+bool FlowField::pointsInto(int cell, int target) const {
+    double d = distance_[static_cast<std::size_t>(cell)];
+    if (d == kInfinity || d == 0.0) {
+        return false;
+    }
+    int dir = getDirectionAt(cell);
+    return index(cell % width_ + kDx[dir], cell / width_ + kDy[dir]) == target;
+}
+
+void FlowField::build(const Maze& maze) {
+    build(maze, maze.getGoal());
+}
+
+void FlowField::build(const Maze& maze, const Point& goal) {
+    width_ = maze.getWidth();
+    height_ = maze.getHeight();
+    goal_ = goal;
+
+    std::size_t cells = static_cast<std::size_t>(width_ * height_);
+    distance_.assign(cells, kInfinity);
+    directions_.assign((cells + 3) / 4, 0);
+    built_ = true;
+
+    if (!maze.isWalkable(goal)) {
+        return;
+    }
+
+    int goalIdx = index(goal.getX(), goal.getY());
+    distance_[static_cast<std::size_t>(goalIdx)] = 0.0;
+
+    std::vector<int> seeds(1, goalIdx);
+    propagate(maze, seeds);
+}
+
+// Reverse Dijkstra: a cell's distance is the cost of the cells entered on
+// the way to the goal, so moving into u from a neighbour adds cost(u).
+void FlowField::propagate(const Maze& maze, std::vector<int>& seeds) {
+    MinQueue queue;
+    for (int cell : seeds) {
+        queue.push(QueueItem(distance_[static_cast<std::size_t>(cell)], cell));
+    }
+
+    while (!queue.empty()) {
+        QueueItem top = queue.top();
+        queue.pop();
+
+        int u = top.second;
+        if (top.first > distance_[static_cast<std::size_t>(u)]) continue;
+
+        int ux = u % width_;
+        int uy = u / width_;
+        double enterCost = maze.getCellCost(Point(ux, uy));
+
+        for (int dir = 0; dir < 4; dir++) {
+            int vx = ux + kDx[dir];
+            int vy = uy + kDy[dir];
+            if (!inBounds(vx, vy) || !maze.isWalkable(Point(vx, vy))) continue;
+
+            int v = index(vx, vy);
+            double candidate = top.first + enterCost;
+            if (candidate + kEpsilon < distance_[static_cast<std::size_t>(v)]) {
+                distance_[static_cast<std::size_t>(v)] = candidate;
+                setDirectionAt(v, (dir + 2) & 3);
+                queue.push(QueueItem(candidate, v));
+            }
+        }
+    }
+}
+
+void FlowField::relaxFromNeighbors(const Maze& maze, int cell) {
+    int x = cell % width_;
+    int y = cell / width_;
+
+    for (int dir = 0; dir < 4; dir++) {
+        int nx = x + kDx[dir];
+        int ny = y + kDy[dir];
+        if (!inBounds(nx, ny)) continue;
+
+        double through = distance_[static_cast<std::size_t>(index(nx, ny))];
+        if (through == kInfinity) continue;
+
+        double candidate = through + maze.getCellCost(Point(nx, ny));
+        if (candidate + kEpsilon < distance_[static_cast<std::size_t>(cell)]) {
+            distance_[static_cast<std::size_t>(cell)] = candidate;
+            setDirectionAt(cell, dir);
+        }
+    }
+}
+
+void FlowField::collectDependents(int root, std::vector<int>& out) const {
+    std::vector<int> stack(1, root);
+    while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+
+        int ux = u % width_;
+        int uy = u / width_;
+        for (int dir = 0; dir < 4; dir++) {
+            int vx = ux + kDx[dir];
+            int vy = uy + kDy[dir];
+            if (!inBounds(vx, vy)) continue;
+
+            int v = index(vx, vy);
+            if (pointsInto(v, u)) {
+                out.push_back(v);
+                stack.push_back(v);
+            }
+        }
+    }
+}
+
+void FlowField::updateCell(const Maze& maze, const Point& p, char previous) {
+    if (!built_ || !inBounds(p.getX(), p.getY())) {
+        return;
+    }
+    if (maze.getWidth() != width_ || maze.getHeight() != height_) {
+        build(maze, goal_);
+        return;
+    }
+
+    const CostModel& model = maze.getCostModel();
+    double oldCost = model.getCost(previous);
+    double newCost = maze.getCellCost(p);
+    if (oldCost == newCost) {
+        return;
+    }
+
+    int cell = index(p.getX(), p.getY());
+    std::vector<int> seeds;
+
+    if (newCost < oldCost) {
+        // Cheaper (or newly opened) cell: only distances can shrink, so a
+        // decrease-only Dijkstra seeded at the cell repairs the field.
+        if (oldCost == CostModel::impassable()) {
+            relaxFromNeighbors(maze, cell);
+        }
+        if (distance_[static_cast<std::size_t>(cell)] != kInfinity) {
+            seeds.push_back(cell);
+            propagate(maze, seeds);
+        }
+        return;
+    }
+
+    // Dearer (or newly closed) cell: every cell whose flow runs into it may
+    // now be wrong. Clear that region, then rebuild it from its frontier.
+    std::vector<int> affected;
+    collectDependents(cell, affected);
+    if (newCost == CostModel::impassable()) {
+        if (cell == index(goal_.getX(), goal_.getY())) {
+            build(maze, goal_);
+            return;
+        }
+        affected.push_back(cell);
+    }
+
+    for (int v : affected) {
+        distance_[static_cast<std::size_t>(v)] = kInfinity;
+    }
+    for (int v : affected) {
+        if (maze.isWalkable(Point(v % width_, v / width_))) {
+            relaxFromNeighbors(maze, v);
+            if (distance_[static_cast<std::size_t>(v)] != kInfinity) {
+                seeds.push_back(v);
+            }
+        }
+    }
+    propagate(maze, seeds);
+}
+
+void FlowField::setCell(Maze& maze, const Point& p, char value) {
+    char previous = maze.getCellAt(p);
+    maze.setCellAt(p, value);
+    updateCell(maze, p, previous);
+}
+
+bool FlowField::isBuilt() const {
+    return built_;
+}
+
+Point FlowField::getGoal() const {
+    return goal_;
+}
+
+bool FlowField::canReachGoal(const Point& p) const {
+    return getDistance(p) != kInfinity;
+}
+
+double FlowField::getDistance(const Point& p) const {
+    if (!built_ || !inBounds(p.getX(), p.getY())) {
+        return kInfinity;
+    }
+    return distance_[static_cast<std::size_t>(index(p.getX(), p.getY()))];
+}
+
+int FlowField::getDirection(const Point& p) const {
+    double d = getDistance(p);
+    if (d == kInfinity || d == 0.0) {
+        return -1;
+    }
+    return getDirectionAt(index(p.getX(), p.getY()));
+}
+
+Point FlowField::getNextStep(const Point& p) const {
+    int dir = getDirection(p);
+    if (dir < 0) {
+        return p;
+    }
+    return Point(p.getX() + kDx[dir], p.getY() + kDy[dir]);
+}
+
+int FlowField::advanceAgents(std::vector<Point>& agents) const {
+    int moved = 0;
+    for (auto& agent : agents) {
+        Point next = getNextStep(agent);
+        if (next != agent) {
+            agent = next;
+            moved++;
+        }
+    }
+    return moved;
+}
@@ -19,6 +19,10 @@ namespace {
     constexpr short PAIR_HUD_VALUE = 9;
     constexpr short PAIR_VICTORY_BG = 10;
     constexpr short PAIR_VICTORY_FG = 11;
+
+    // Expansions granted to the hint search per frame; far below the 60 ms
+    // input timeout even on large maps.
+    constexpr int kHintNodesPerFrame = 2000;
 }
 
 GameMode::GameMode(Maze& maze, Renderer& renderer, CLIUtils& cli)
@@ -31,7 +35,10 @@ GameMode::GameMode(Maze& maze, Renderer& renderer, CLIUtils& cli)
       startTime_(),
       gameWon_(false),
       gameRunning_(false),
-      frameCounter_(0) {}
+      frameCounter_(0),
+      hintSearch_(),
+      hintPending_(false),
+      hintCells_() {}
 
 GameMode::~GameMode() {
     if (gameRunning_) {
@@ -81,6 +88,7 @@ void GameMode::startGame() {
     gameRunning_ = true;
     frameCounter_ = 0;
     statusLog_.clear();
+    clearHint();
 
     initNcurses();
     
@@ -91,7 +99,7 @@ void GameMode::startGame() {
     
     std::string startMsg = "GAME STARTED";
     std::string goodLuck = "Good luck!";
-    std::string controls = "Use Arrow Keys or WASD to move | Press Q to quit";
+    std::string controls = "Use Arrow Keys or WASD to move | H for a hint | Press Q to quit";
     
     attron(COLOR_PAIR(PAIR_HUD_VALUE) | A_BOLD);
     mvwprintw(stdscr, rows / 2 - 2, (cols - startMsg.length()) / 2, "%s", startMsg.c_str());
@@ -110,6 +118,7 @@ void GameMode::startGame() {
 
     while (gameRunning_) {
         handleInput();
+        advanceHint();
         updateDisplay();
         pruneLog();
         frameCounter_++;
@@ -143,6 +152,9 @@ void GameMode::handleInput() {
         case KEY_RIGHT: case 'd': case 'D':
             newPos = playerPos_ + Point(1, 0);
             break;
+        case 'h': case 'H':
+            requestHint();
+            return;
         case 'q': case 'Q': case 27: 
             gameRunning_ = false;
             logStatus("Exiting game...");
@@ -157,6 +169,7 @@ void GameMode::handleInput() {
     if (isValidMove(newPos)) {
         playerPos_ = newPos;
         moves_++;
+        clearHint();
         logStatus("Moved to (" + std::to_string(newPos.getX()) + ", " + std::to_string(newPos.getY()) + ")");
     } else {
         logStatus("Blocked! Cannot move there.");
@@ -167,6 +180,42 @@ bool GameMode::isValidMove(const Point& newPos) const {
     return maze_ && maze_->isWalkable(newPos);
 }
 
+void GameMode::requestHint() {
+    clearHint();
+    if (!hintSearch_.begin(*maze_, playerPos_, goalPos_)) {
+        logStatus("No hint available from here.");
+        return;
+    }
+    hintPending_ = true;
+    logStatus("Searching for a hint...");
+}
+
+void GameMode::advanceHint() {
+    if (!hintPending_ || !hintSearch_.step(kHintNodesPerFrame)) {
+        return;
+    }
+    hintPending_ = false;
+
+    SolveResult result = hintSearch_.result();
+    if (!result.isFound()) {
+        logStatus("No route to the goal from here.");
+        return;
+    }
+
+    const Path& path = result.getPath();
+    hintCells_.assign(static_cast<std::size_t>(maze_->getWidth() * maze_->getHeight()), false);
+    for (int i = 0; i < path.getSize(); i++) {
+        Point p = path.getPointAt(i);
+        hintCells_[static_cast<std::size_t>(p.getY() * maze_->getWidth() + p.getX())] = true;
+    }
+    logStatus("Hint: " + std::to_string(std::max(0, path.getSize() - 1)) + " steps to the goal.");
+}
+
+void GameMode::clearHint() {
+    hintPending_ = false;
+    hintCells_.clear();
+}
+
 void GameMode::updateDisplay() {
     clear();
     drawLayout();
@@ -213,6 +262,9 @@ void GameMode::drawMaze() {
             } else if (currentPos == goalPos_) {
                 pair = PAIR_GOAL;
                 glyph = (frameCounter_ % 30 < 15) ? "★ " : "☆ ";
+            } else if (!hintCells_.empty() && hintCells_[static_cast<std::size_t>(y * mazeWidth + x)]) {
+                pair = PAIR_GOAL;
+                glyph = "··";
             } else {
                 switch (cell) {
                     case '#': pair = PAIR_WALL; glyph = "██"; break;
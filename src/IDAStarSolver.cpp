@@ -0,0 +1,220 @@
+#include "IDAStarSolver.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    const Point kDirections[4] = {
+        Point(0, -1), Point(1, 0), Point(0, 1), Point(-1, 0)
+    };
+
+    const double kEpsilon = 1e-9;
+
+    // Rough per-node footprint of the standard hashed containers: the stored
+    // value, a next pointer and the cached hash, plus one bucket slot.
+    template <typename Container>
+    std::size_t hashedBytes(const Container& container, std::size_t valueSize) {
+        std::size_t nodeBytes = valueSize + sizeof(void*) + sizeof(std::size_t);
+        return container.size() * nodeBytes + container.bucket_count() * sizeof(void*);
+    }
+}
+
+IDAStarSolver::IDAStarSolver(std::size_t tableCapacity)
+    : tableCapacity_(tableCapacity),
+      table_(),
+      onPath_(),
+      stack_(),
+      nodesExplored_(0),
+      iterations_(0),
+      peakBytes_(0),
+      heuristicScale_(1.0) {}
+
+int IDAStarSolver::pointToIndex(const Point& p, int width) const {
+    return p.getY() * width + p.getX();
+}
+
+double IDAStarSolver::getCellCost(const Maze& maze, const Point& p) const {
+    return maze.getCellCost(p);
+}
+
+double IDAStarSolver::heuristic(const Point& p, const Point& goal) const {
+    return heuristicScale_ * static_cast<double>(p.manhattanDistance(goal));
+}
+
+bool IDAStarSolver::isPrunedByTable(int index, double g, int iteration) {
+    auto it = table_.find(index);
+    if (it != table_.end()) {
+        if (it->second.iteration == iteration && it->second.g <= g + kEpsilon) {
+            return true;
+        }
+        it->second.g = g;
+        it->second.iteration = iteration;
+        return false;
+    }
+
+    if (table_.size() < tableCapacity_) {
+        TableEntry entry;
+        entry.g = g;
+        entry.iteration = iteration;
+        table_.emplace(index, entry);
+    }
+    return false;
+}
+
+std::size_t IDAStarSolver::currentBytes() const {
+    return stack_.capacity() * sizeof(Frame) +
+           hashedBytes(onPath_, sizeof(int)) +
+           hashedBytes(table_, sizeof(std::pair<const int, TableEntry>));
+}
+
+void IDAStarSolver::releaseSearchState() {
+    std::vector<Frame>().swap(stack_);
+    std::unordered_set<int>().swap(onPath_);
+    std::unordered_map<int, TableEntry>().swap(table_);
+}
+
+Path IDAStarSolver::buildPath() const {
+    Path path;
+    for (const auto& frame : stack_) {
+        path.addPoint(frame.point);
+    }
+    path.setCost(stack_.empty() ? 0.0 : stack_.back().g);
+    return path;
+}
+
+SolveResult IDAStarSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
+    Point start = maze.getStart();
+    Point goal = maze.getGoal();
+    int width = maze.getWidth();
+
+    nodesExplored_ = 0;
+    iterations_ = 0;
+    peakBytes_ = 0;
+    releaseSearchState();
+
+    if (!maze.isWalkable(start) || !maze.isWalkable(goal)) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
+    // The reachability index costs memory proportional to the maze area,
+    // so it is only consulted when someone else has already built it.
+    if (maze.hasReachabilityIndex() && !maze.areConnected(start, goal)) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
+    SolveBudget budget(options);
+    heuristicScale_ = maze.getCostModel().getMinimumCost();
+
+    table_.reserve(std::min<std::size_t>(tableCapacity_, 1024));
+
+    double threshold = heuristic(start, goal);
+
+    while (true) {
+        iterations_++;
+        double nextThreshold = std::numeric_limits<double>::infinity();
+
+        stack_.clear();
+        onPath_.clear();
+
+        Frame root;
+        root.point = start;
+        root.g = 0.0;
+        root.nextDirection = 0;
+        root.expanded = false;
+        stack_.push_back(root);
+        onPath_.insert(pointToIndex(start, width));
+
+        while (!stack_.empty()) {
+            Frame& top = stack_.back();
+
+            if (!top.expanded) {
+                double f = top.g + heuristic(top.point, goal);
+                if (f > threshold + kEpsilon) {
+                    nextThreshold = std::min(nextThreshold, f);
+                    onPath_.erase(pointToIndex(top.point, width));
+                    stack_.pop_back();
+                    continue;
+                }
+
+                if (top.point == goal) {
+                    peakBytes_ = std::max(peakBytes_, currentBytes());
+                    Path path = buildPath();
+                    releaseSearchState();
+                    return SolveResult(SolveStatus::Found, path);
+                }
+
+                if (!budget.consume()) {
+                    releaseSearchState();
+                    return SolveResult(budget.getStopStatus());
+                }
+                top.expanded = true;
+                nodesExplored_++;
+            }
+
+            if (top.nextDirection >= 4) {
+                onPath_.erase(pointToIndex(top.point, width));
+                stack_.pop_back();
+                continue;
+            }
+
+            Point neighbor = top.point + kDirections[top.nextDirection];
+            top.nextDirection++;
+
+            if (!maze.isWalkable(neighbor)) {
+                continue;
+            }
+
+            int neighborIdx = pointToIndex(neighbor, width);
+            if (onPath_.count(neighborIdx) != 0 || !options.isCellAllowed(neighborIdx)) {
+                continue;
+            }
+
+            double g = top.g + getCellCost(maze, neighbor);
+            if (isPrunedByTable(neighborIdx, g, iterations_)) {
+                continue;
+            }
+
+            Frame child;
+            child.point = neighbor;
+            child.g = g;
+            child.nextDirection = 0;
+            child.expanded = false;
+            stack_.push_back(child);
+            onPath_.insert(neighborIdx);
+
+            peakBytes_ = std::max(peakBytes_, currentBytes());
+        }
+
+        if (nextThreshold == std::numeric_limits<double>::infinity()) {
+            break;
+        }
+        threshold = nextThreshold;
+    }
+
+    releaseSearchState();
+    return SolveResult(SolveStatus::Unreachable);
+}
+
+int IDAStarSolver::getNodesExplored() const {
+    return nodesExplored_;
+}
+
+std::string IDAStarSolver::name() const {
+    return "IDA* (Low Memory)";
+}
+
+void IDAStarSolver::setTableCapacity(std::size_t capacity) {
+    tableCapacity_ = capacity;
+}
+
+std::size_t IDAStarSolver::getTableCapacity() const {
+    return tableCapacity_;
+}
+
+int IDAStarSolver::getIterations() const {
+    return iterations_;
+}
+
+std::size_t IDAStarSolver::getPeakBytes() const {
+    return peakBytes_;
+}
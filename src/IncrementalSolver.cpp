@@ -0,0 +1,249 @@
+#include "IncrementalSolver.h"
+
+#include <algorithm>
+#include <limits>
+
+IncrementalSolver::IncrementalSolver()
+    : maze_(nullptr),
+      options_(),
+      budget_(),
+      start_(0, 0),
+      goal_(0, 0),
+      width_(0),
+      parent_(),
+      distance_(),
+      closed_(),
+      nodesExplored_(0),
+      done_(true),
+      status_(SolveStatus::Unreachable),
+      path_() {}
+
+int IncrementalSolver::toIndex(const Point& p) const {
+    return p.getY() * width_ + p.getX();
+}
+
+Point IncrementalSolver::toPoint(int index) const {
+    return Point(index % width_, index / width_);
+}
+
+const Maze& IncrementalSolver::getMaze() const {
+    return *maze_;
+}
+
+const Point& IncrementalSolver::getGoal() const {
+    return goal_;
+}
+
+bool IncrementalSolver::begin(const Maze& maze, const SolveOptions& options) {
+    return begin(maze, maze.getStart(), maze.getGoal(), options);
+}
+
+bool IncrementalSolver::begin(const Maze& maze, const Point& start, const Point& goal,
+                              const SolveOptions& options) {
+    maze_ = &maze;
+    options_ = options;
+    // The budget keeps counting across step() calls.
+    budget_.reset(new SolveBudget(options_));
+    start_ = start;
+    goal_ = goal;
+    width_ = maze.getWidth();
+    nodesExplored_ = 0;
+    path_ = Path();
+    clearOpen();
+
+    // The reachability index is deliberately not consulted: building it is a
+    // full flood fill, which is exactly the kind of stall this API avoids.
+    if (!maze.isWalkable(start) || !maze.isWalkable(goal)) {
+        parent_.clear();
+        distance_.clear();
+        closed_.clear();
+        finish(SolveStatus::Unreachable);
+        return false;
+    }
+
+    std::size_t cells = static_cast<std::size_t>(width_) * static_cast<std::size_t>(maze.getHeight());
+    parent_.assign(cells, -1);
+    distance_.assign(cells, std::numeric_limits<double>::infinity());
+    closed_.assign(cells, false);
+
+    int startIdx = toIndex(start);
+    distance_[static_cast<std::size_t>(startIdx)] = 0.0;
+    pushOpen(startIdx, 0.0);
+
+    done_ = false;
+    status_ = SolveStatus::BudgetExceeded;
+    return true;
+}
+
+void IncrementalSolver::finish(SolveStatus status) {
+    done_ = true;
+    status_ = status;
+    if (status == SolveStatus::Found) {
+        path_ = reconstructPath();
+    }
+    clearOpen();
+}
+
+bool IncrementalSolver::step(int maxNodes) {
+    if (done_) {
+        return true;
+    }
+    if (!budget_->poll()) {
+        finish(budget_->getStopStatus());
+        return true;
+    }
+
+    const Maze& maze = *maze_;
+    const int goalIdx = toIndex(goal_);
+
+    int expanded = 0;
+    int current = -1;
+    while (expanded < maxNodes) {
+        if (!popOpen(current)) {
+            finish(SolveStatus::Unreachable);
+            return true;
+        }
+        if (closed_[static_cast<std::size_t>(current)]) {
+            continue;
+        }
+
+        if (!budget_->consume()) {
+            finish(budget_->getStopStatus());
+            return true;
+        }
+        closed_[static_cast<std::size_t>(current)] = true;
+        nodesExplored_++;
+        expanded++;
+
+        if (current == goalIdx) {
+            finish(SolveStatus::Found);
+            return true;
+        }
+
+        Point currentPoint = toPoint(current);
+        double currentDistance = distance_[static_cast<std::size_t>(current)];
+
+        Point neighbors[4];
+        int neighborCount;
+        maze.getNeighbors(currentPoint, neighbors, neighborCount);
+
+        for (int i = 0; i < neighborCount; i++) {
+            int neighborIdx = toIndex(neighbors[i]);
+            if (closed_[static_cast<std::size_t>(neighborIdx)] || !options_.isCellAllowed(neighborIdx)) {
+                continue;
+            }
+
+            double candidate = currentDistance + stepCost(neighbors[i]);
+            if (candidate < distance_[static_cast<std::size_t>(neighborIdx)]) {
+                distance_[static_cast<std::size_t>(neighborIdx)] = candidate;
+                parent_[static_cast<std::size_t>(neighborIdx)] = current;
+                pushOpen(neighborIdx, candidate);
+            }
+        }
+    }
+
+    return false;
+}
+
+bool IncrementalSolver::stepUntil(const SolveOptions::Clock::time_point& deadline, int chunkNodes) {
+    chunkNodes = std::max(1, chunkNodes);
+    while (!step(chunkNodes)) {
+        if (SolveOptions::Clock::now() >= deadline) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Path IncrementalSolver::reconstructPath() const {
+    std::vector<Point> reverse;
+    int startIdx = toIndex(start_);
+    for (int current = toIndex(goal_); current != -1; current = parent_[static_cast<std::size_t>(current)]) {
+        reverse.push_back(toPoint(current));
+        if (current == startIdx) break;
+    }
+
+    Path path;
+    for (auto it = reverse.rbegin(); it != reverse.rend(); ++it) {
+        path.addPoint(*it);
+    }
+    path.setCost(distance_[static_cast<std::size_t>(toIndex(goal_))]);
+    return path;
+}
+
+bool IncrementalSolver::isDone() const {
+    return done_;
+}
+
+SolveResult IncrementalSolver::result() const {
+    if (status_ == SolveStatus::Found) {
+        return SolveResult(status_, path_);
+    }
+    return SolveResult(status_);
+}
+
+int IncrementalSolver::getNodesExplored() const {
+    return nodesExplored_;
+}
+
+void IncrementalBFS::clearOpen() {
+    open_.clear();
+}
+
+void IncrementalBFS::pushOpen(int index, double) {
+    open_.push_back(index);
+}
+
+bool IncrementalBFS::popOpen(int& index) {
+    if (open_.empty()) {
+        return false;
+    }
+    index = open_.front();
+    open_.pop_front();
+    return true;
+}
+
+double IncrementalBFS::stepCost(const Point&) const {
+    return 1.0;
+}
+
+std::string IncrementalBFS::name() const {
+    return "Breadth-First Search (Incremental)";
+}
+
+double IncrementalDijkstra::heuristic(const Point&) const {
+    return 0.0;
+}
+
+void IncrementalDijkstra::clearOpen() {
+    open_ = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>();
+}
+
+void IncrementalDijkstra::pushOpen(int index, double g) {
+    open_.push(std::make_pair(g + heuristic(toPoint(index)), index));
+}
+
+bool IncrementalDijkstra::popOpen(int& index) {
+    if (open_.empty()) {
+        return false;
+    }
+    index = open_.top().second;
+    open_.pop();
+    return true;
+}
+
+double IncrementalDijkstra::stepCost(const Point& p) const {
+    return getMaze().getCellCost(p);
+}
+
+std::string IncrementalDijkstra::name() const {
+    return "Dijkstra's Algorithm (Incremental)";
+}
+
+double IncrementalAStar::heuristic(const Point& p) const {
+    return getMaze().getCostModel().getMinimumCost() * static_cast<double>(p.manhattanDistance(getGoal()));
+}
+
+std::string IncrementalAStar::name() const {
+    return "A* (Incremental)";
+}
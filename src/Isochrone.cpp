@@ -0,0 +1,153 @@
+#include "Isochrone.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace {
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+    const double kEpsilon = 1e-9;
+
+    typedef std::pair<double, int> HeapItem;
+}
+
+Isochrone::Isochrone() : width_(0), height_(0), origin_(0, 0), budget_(0.0) {}
+
+int Isochrone::find(const Point& p) const {
+    if (p.getX() < 0 || p.getX() >= width_ || p.getY() < 0 || p.getY() >= height_) {
+        return -1;
+    }
+    int cell = p.getY() * width_ + p.getX();
+    auto it = std::lower_bound(cells_.begin(), cells_.end(), cell);
+    if (it == cells_.end() || *it != cell) {
+        return -1;
+    }
+    return static_cast<int>(it - cells_.begin());
+}
+
+Point Isochrone::getOrigin() const {
+    return origin_;
+}
+
+double Isochrone::getBudget() const {
+    return budget_;
+}
+
+int Isochrone::getSize() const {
+    return static_cast<int>(cells_.size());
+}
+
+const std::vector<int>& Isochrone::getCells() const {
+    return cells_;
+}
+
+const std::vector<double>& Isochrone::getCosts() const {
+    return costs_;
+}
+
+Point Isochrone::getPointAt(int index) const {
+    int cell = cells_[static_cast<std::size_t>(index)];
+    return Point(cell % width_, cell / width_);
+}
+
+bool Isochrone::contains(const Point& p) const {
+    return find(p) >= 0;
+}
+
+double Isochrone::getCost(const Point& p) const {
+    int index = find(p);
+    return index < 0 ? std::numeric_limits<double>::infinity() : costs_[static_cast<std::size_t>(index)];
+}
+
+void Isochrone::fillBitset(std::vector<std::uint64_t>& bits) const {
+    bits.assign((static_cast<std::size_t>(width_ * height_) + 63) / 64, 0);
+    for (int cell : cells_) {
+        bits[static_cast<std::size_t>(cell) / 64] |= std::uint64_t(1) << (cell % 64);
+    }
+}
+
+IsochroneQuery::IsochroneQuery() : generation_(0), nodesExplored_(0) {}
+
+// Distances are stamped with a generation instead of being cleared, so a
+// small query on a large maze touches only the cells it reaches.
+void IsochroneQuery::prepare(int cells) {
+    if (distance_.size() != static_cast<std::size_t>(cells)) {
+        distance_.assign(static_cast<std::size_t>(cells), 0.0);
+        stamp_.assign(static_cast<std::size_t>(cells), 0);
+        generation_ = 0;
+    }
+    if (++generation_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        generation_ = 1;
+    }
+    heap_.clear();
+}
+
+Isochrone IsochroneQuery::compute(const Maze& maze, const Point& origin, double budget) {
+    Isochrone result;
+    result.width_ = maze.getWidth();
+    result.height_ = maze.getHeight();
+    result.origin_ = origin;
+    result.budget_ = budget;
+    nodesExplored_ = 0;
+
+    if (!maze.isWalkable(origin) || budget < 0.0) {
+        return result;
+    }
+
+    const int width = maze.getWidth();
+    prepare(width * maze.getHeight());
+
+    auto seen = [this](int cell) {
+        return stamp_[static_cast<std::size_t>(cell)] == generation_;
+    };
+
+    const int originCell = origin.getY() * width + origin.getX();
+    distance_[static_cast<std::size_t>(originCell)] = 0.0;
+    stamp_[static_cast<std::size_t>(originCell)] = generation_;
+    heap_.push_back(HeapItem(0.0, originCell));
+
+    // Candidates past the budget are never queued, so the search ends as
+    // soon as the budget frontier has been settled.
+    while (!heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<HeapItem>());
+        HeapItem top = heap_.back();
+        heap_.pop_back();
+
+        const int cell = top.second;
+        if (top.first > distance_[static_cast<std::size_t>(cell)]) continue;
+
+        nodesExplored_++;
+        result.cells_.push_back(cell);
+
+        const int x = cell % width;
+        const int y = cell / width;
+        for (int dir = 0; dir < 4; dir++) {
+            Point next(x + kDx[dir], y + kDy[dir]);
+            if (!maze.isWalkable(next)) continue;
+
+            int nextCell = next.getY() * width + next.getX();
+            double candidate = top.first + maze.getCellCost(next);
+            if (candidate > budget + kEpsilon) continue;
+
+            if (!seen(nextCell) || candidate < distance_[static_cast<std::size_t>(nextCell)]) {
+                distance_[static_cast<std::size_t>(nextCell)] = candidate;
+                stamp_[static_cast<std::size_t>(nextCell)] = generation_;
+                heap_.push_back(HeapItem(candidate, nextCell));
+                std::push_heap(heap_.begin(), heap_.end(), std::greater<HeapItem>());
+            }
+        }
+    }
+
+    std::sort(result.cells_.begin(), result.cells_.end());
+    result.costs_.reserve(result.cells_.size());
+    for (int cell : result.cells_) {
+        result.costs_.push_back(distance_[static_cast<std::size_t>(cell)]);
+    }
+    return result;
+}
+
+int IsochroneQuery::getNodesExplored() const {
+    return nodesExplored_;
+}
@@ -0,0 +1,173 @@
+#include "MappedMaze.h"
+
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedMaze::MappedMaze()
+    : data_(nullptr),
+      size_(0),
+      cellsOffset_(0),
+      rowStride_(0),
+      cellStride_(1),
+      width_(0),
+      height_(0),
+      start_(0, 0),
+      goal_(0, 0),
+      costModel_(CostModel::standard()) {}
+
+MappedMaze::~MappedMaze() {
+    close();
+}
+
+bool MappedMaze::open(const char* filename) {
+    close();
+
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    data_ = static_cast<const char*>(mapped);
+    size_ = static_cast<std::size_t>(info.st_size);
+    madvise(mapped, size_, MADV_RANDOM);
+
+    if (!parseLayout()) {
+        close();
+        return false;
+    }
+    findEndpoints();
+    return true;
+}
+
+void MappedMaze::close() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    width_ = 0;
+    height_ = 0;
+}
+
+bool MappedMaze::isOpen() const {
+    return data_ != nullptr;
+}
+
+// Cells are addressed in place, so only fixed-stride layouts are accepted:
+// the space-separated rows written by Maze::saveToFile, or unseparated rows.
+bool MappedMaze::parseLayout() {
+    std::size_t pos = 0;
+    long long dims[2] = {0, 0};
+    for (int i = 0; i < 2; i++) {
+        while (pos < size_ && std::isspace(static_cast<unsigned char>(data_[pos]))) pos++;
+        if (pos >= size_ || !std::isdigit(static_cast<unsigned char>(data_[pos]))) return false;
+        while (pos < size_ && std::isdigit(static_cast<unsigned char>(data_[pos]))) {
+            dims[i] = dims[i] * 10 + (data_[pos++] - '0');
+            if (dims[i] > (1LL << 30)) return false;
+        }
+    }
+    while (pos < size_ && data_[pos] != '\n') pos++;
+    pos++;
+
+    if (dims[0] <= 0 || dims[1] <= 0 || pos >= size_) {
+        return false;
+    }
+    width_ = static_cast<int>(dims[0]);
+    height_ = static_cast<int>(dims[1]);
+    cellsOffset_ = pos;
+
+    cellStride_ = (width_ > 1 && data_[pos + 1] == ' ') ? 2 : 1;
+    rowStride_ = static_cast<std::size_t>(width_) * cellStride_ + (cellStride_ == 2 ? 0 : 1);
+
+    std::size_t lastRowEnd = cellsOffset_ + static_cast<std::size_t>(height_) * rowStride_ - 1;
+    return lastRowEnd < size_ &&
+           data_[cellsOffset_ + rowStride_ - 1] == '\n' &&
+           data_[lastRowEnd] == '\n';
+}
+
+void MappedMaze::findEndpoints() {
+    const char* cells = data_ + cellsOffset_;
+    std::size_t span = static_cast<std::size_t>(height_) * rowStride_;
+
+    const char* s = static_cast<const char*>(std::memchr(cells, 'S', span));
+    const char* g = static_cast<const char*>(std::memchr(cells, 'G', span));
+    if (s != nullptr) {
+        std::size_t offset = static_cast<std::size_t>(s - cells);
+        start_ = Point(static_cast<int>((offset % rowStride_) / cellStride_), static_cast<int>(offset / rowStride_));
+    }
+    if (g != nullptr) {
+        std::size_t offset = static_cast<std::size_t>(g - cells);
+        goal_ = Point(static_cast<int>((offset % rowStride_) / cellStride_), static_cast<int>(offset / rowStride_));
+    }
+}
+
+int MappedMaze::getWidth() const {
+    return width_;
+}
+
+int MappedMaze::getHeight() const {
+    return height_;
+}
+
+Point MappedMaze::getStart() const {
+    return start_;
+}
+
+Point MappedMaze::getGoal() const {
+    return goal_;
+}
+
+char MappedMaze::getCellAt(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return '#';
+    }
+    return data_[cellsOffset_ + static_cast<std::size_t>(y) * rowStride_ + static_cast<std::size_t>(x) * cellStride_];
+}
+
+char MappedMaze::getCellAt(const Point& p) const {
+    return getCellAt(p.getX(), p.getY());
+}
+
+const CostModel& MappedMaze::getCostModel() const {
+    return *costModel_;
+}
+
+double MappedMaze::getCellCost(const Point& p) const {
+    return costModel_->getCost(getCellAt(p));
+}
+
+void MappedMaze::setStart(const Point& p) {
+    start_ = p;
+}
+
+void MappedMaze::setGoal(const Point& p) {
+    goal_ = p;
+}
+
+void MappedMaze::setCostModel(const std::shared_ptr<const CostModel>& model) {
+    costModel_ = model ? model : CostModel::standard();
+}
+
+bool MappedMaze::isValid(const Point& p) const {
+    return p.getX() >= 0 && p.getX() < width_ && p.getY() >= 0 && p.getY() < height_;
+}
+
+bool MappedMaze::isWalkable(const Point& p) const {
+    return isValid(p) && costModel_->isPassable(getCellAt(p));
+}
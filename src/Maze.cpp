@@ -1,26 +1,237 @@
 #include "Maze.h"
 
 #include <algorithm>
+#include <atomic>
 
-Maze::Maze() : grid_(), width_(0), height_(0), start_(0, 0), goal_(0, 0) {}
+namespace {
+    const char kFloor = '.';
+    const char kBasePalette[2] = {'.', '#'};
 
-Maze::Maze(int width, int height)
-    : grid_(static_cast<std::size_t>(width * height), '.'),
+    // Process-wide, so a revision names one cell and cost state even
+    // across different Maze objects.
+    std::uint64_t nextRevision() {
+        static std::atomic<std::uint64_t> counter(0);
+        return ++counter;
+    }
+}
+
+Maze::Maze()
+    : grid_(),
+      width_(0),
+      height_(0),
+      layout_(),
+      start_(0, 0),
+      goal_(0, 0),
+      costModel_(CostModel::standard()),
+      reachability_(),
+      revision_(nextRevision()),
+      storage_(CellStorage::Bytes),
+      packed_(),
+      bitsPerCell_(2),
+      packShift_(2),
+      paletteSize_(0),
+      openMasks_() {
+    resetPalette();
+    allocateCells('#');
+    rebuildOpenMasks();
+}
+
+Maze::Maze(int width, int height) : Maze(width, height, CellStorage::Bytes) {}
+
+Maze::Maze(int width, int height, CellStorage storage)
+    : grid_(),
       width_(width),
       height_(height),
+      layout_(),
       start_(0, 0),
-      goal_(0, 0) {}
-
-int Maze::index(int x, int y) const {
-    return y * width_ + x;
+      goal_(0, 0),
+      costModel_(CostModel::standard()),
+      reachability_(),
+      revision_(nextRevision()),
+      storage_(storage),
+      packed_(),
+      bitsPerCell_(2),
+      packShift_(2),
+      paletteSize_(0),
+      openMasks_() {
+    resetPalette();
+    allocateCells(kFloor);
+    rebuildOpenMasks();
 }
 
 char Maze::getCellUnchecked(int x, int y) const {
-    return grid_[static_cast<std::size_t>(index(x, y))];
+    return getCellAtIndex(cellIndex(x, y));
 }
 
 void Maze::setCellUnchecked(int x, int y, char value) {
-    grid_[static_cast<std::size_t>(index(x, y))] = value;
+    if (storage_ == CellStorage::Bytes) {
+        grid_[static_cast<std::size_t>(cellIndex(x, y))] = value;
+        return;
+    }
+
+    int code = paletteCodes_[static_cast<unsigned char>(value)];
+    if (code == 0) {
+        if (paletteSize_ == 16) {
+            setStorage(CellStorage::Bytes);
+            grid_[static_cast<std::size_t>(cellIndex(x, y))] = value;
+            return;
+        }
+        code = addToPalette(value) + 1;
+    }
+    writeCode(static_cast<std::size_t>(cellIndex(x, y)), code - 1);
+}
+
+void Maze::allocateCells(char fill) {
+    layout_ = CellLayout(width_ + 2, height_ + 2);
+    std::size_t cells = cellCount();
+    if (storage_ == CellStorage::Bytes) {
+        packed_.clear();
+        grid_.assign(cells, '#');
+        for (int y = 0; y < height_; y++) {
+            for (int x = 0; x < width_; x++) {
+                grid_[static_cast<std::size_t>(cellIndex(x, y))] = fill;
+            }
+        }
+        return;
+    }
+
+    grid_.clear();
+    resetPalette();
+    int code = paletteCodes_[static_cast<unsigned char>(fill)];
+    if (code == 0) code = addToPalette(fill) + 1;
+    code -= 1;
+
+    // Everything outside the maze, including any layout padding, is wall.
+    int wall = paletteCodes_[static_cast<unsigned char>('#')] - 1;
+    int perByte = 1 << packShift_;
+    std::uint8_t pattern = 0;
+    for (int slot = 0; slot < perByte; slot++) {
+        pattern = static_cast<std::uint8_t>(pattern | (wall << (slot * bitsPerCell_)));
+    }
+    packed_.assign((cells + static_cast<std::size_t>(perByte) - 1) >> packShift_, pattern);
+
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            writeCode(static_cast<std::size_t>(cellIndex(x, y)), code);
+        }
+    }
+}
+
+void Maze::resetPalette() {
+    std::fill(paletteCodes_, paletteCodes_ + 256, static_cast<unsigned char>(0));
+    std::fill(palette_, palette_ + 16, kFloor);
+    paletteSize_ = 0;
+    bitsPerCell_ = 2;
+    packShift_ = 2;
+    for (char symbol : kBasePalette) {
+        palette_[paletteSize_] = symbol;
+        paletteCodes_[static_cast<unsigned char>(symbol)] = static_cast<unsigned char>(++paletteSize_);
+    }
+}
+
+int Maze::addToPalette(char symbol) {
+    if (paletteSize_ == (1 << bitsPerCell_)) {
+        repack(4);
+    }
+    palette_[paletteSize_] = symbol;
+    paletteCodes_[static_cast<unsigned char>(symbol)] = static_cast<unsigned char>(paletteSize_ + 1);
+    return paletteSize_++;
+}
+
+void Maze::writeCode(std::size_t cell, int code) {
+    int shift = static_cast<int>(cell & ((static_cast<std::size_t>(1) << packShift_) - 1)) * bitsPerCell_;
+    std::uint8_t& byte = packed_[cell >> packShift_];
+    byte = static_cast<std::uint8_t>((byte & ~(((1 << bitsPerCell_) - 1) << shift)) | (code << shift));
+}
+
+void Maze::repack(int bitsPerCell) {
+    std::vector<std::uint8_t> previous;
+    previous.swap(packed_);
+    int previousBits = bitsPerCell_;
+    int previousShift = packShift_;
+
+    bitsPerCell_ = bitsPerCell;
+    packShift_ = bitsPerCell == 2 ? 2 : 1;
+    std::size_t cells = cellCount();
+    packed_.assign((cells + (static_cast<std::size_t>(1) << packShift_) - 1) >> packShift_, 0);
+
+    std::size_t slotMask = (static_cast<std::size_t>(1) << previousShift) - 1;
+    int codeMask = (1 << previousBits) - 1;
+    for (std::size_t cell = 0; cell < cells; cell++) {
+        int shift = static_cast<int>(cell & slotMask) * previousBits;
+        writeCode(cell, (previous[cell >> previousShift] >> shift) & codeMask);
+    }
+}
+
+CellStorage Maze::getStorage() const {
+    return storage_;
+}
+
+bool Maze::setStorage(CellStorage storage) {
+    if (storage == storage_) {
+        return true;
+    }
+
+    if (storage == CellStorage::Bytes) {
+        std::vector<char> grid(cellCount(), '#');
+        for (int y = 0; y < height_; y++) {
+            for (int x = 0; x < width_; x++) {
+                grid[static_cast<std::size_t>(cellIndex(x, y))] = getCellUnchecked(x, y);
+            }
+        }
+        grid_.swap(grid);
+        std::vector<std::uint8_t>().swap(packed_);
+        storage_ = CellStorage::Bytes;
+        rebuildOpenMasks();
+        return true;
+    }
+
+    bool seen[256] = {};
+    int distinct = 0;
+    for (char cell : grid_) {
+        unsigned char key = static_cast<unsigned char>(cell);
+        if (!seen[key]) {
+            seen[key] = true;
+            distinct++;
+        }
+    }
+    for (char symbol : kBasePalette) {
+        if (!seen[static_cast<unsigned char>(symbol)]) distinct++;
+    }
+    if (distinct > 16) {
+        return false;
+    }
+
+    std::vector<char> grid;
+    grid.swap(grid_);
+    storage_ = CellStorage::Packed;
+    allocateCells(kFloor);
+    if (distinct > 4) {
+        repack(4);
+    }
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            setCellUnchecked(x, y, grid[static_cast<std::size_t>(cellIndex(x, y))]);
+        }
+    }
+    rebuildOpenMasks();
+    return true;
+}
+
+int Maze::getBitsPerCell() const {
+    return storage_ == CellStorage::Bytes ? 8 : bitsPerCell_;
+}
+
+std::size_t Maze::getStorageBytes() const {
+    return (storage_ == CellStorage::Bytes ? grid_.size() : packed_.size()) + openMasks_.size();
+}
+
+int Maze::getPaletteSize() const {
+    return paletteSize_;
+}
+
+char Maze::getPaletteSymbol(int code) const {
+    return code >= 0 && code < paletteSize_ ? palette_[code] : '#';
 }
 
 int Maze::getWidth() const {
@@ -50,6 +261,18 @@ char Maze::getCellAt(int x, int y) const {
     return '#';  
 }
 
+const CostModel& Maze::getCostModel() const {
+    return *costModel_;
+}
+
+std::shared_ptr<const CostModel> Maze::getCostModelHandle() const {
+    return costModel_;
+}
+
+double Maze::getCellCost(const Point& p) const {
+    return costModel_->getCost(getCellAt(p));
+}
+
 void Maze::setStart(const Point& p) {
     if (isValid(p)) {
         start_ = p;
@@ -68,23 +291,45 @@ void Maze::setCellAt(const Point& p, char value) {
 
 void Maze::setCellAt(int x, int y, char value) {
     if (x >= 0 && x < width_ && y >= 0 && y < height_) {
+        bool wasWall = !costModel_->isPassable(getCellUnchecked(x, y));
+        bool isWall = !costModel_->isPassable(value);
         setCellUnchecked(x, y, value);
+        revision_ = nextRevision();
+
+        if (wasWall != isWall) {
+            refreshOpenMasksAround(x, y);
+        }
+
+        if (wasWall && !isWall) {
+            reachability_.openCell(*this, x, y);
+        } else if (!wasWall && isWall) {
+            reachability_.invalidate();
+        }
     }
 }
 
+void Maze::setCostModel(const std::shared_ptr<const CostModel>& model) {
+    costModel_ = model ? model : CostModel::standard();
+    revision_ = nextRevision();
+    reachability_.invalidate();
+    rebuildOpenMasks();
+}
+
 bool Maze::loadFromFile(const char* filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
         return false;
     }
 
+    reachability_.invalidate();
+    revision_ = nextRevision();
     file >> width_ >> height_;
 
     if (width_ <= 0 || height_ <= 0) {
         return false;
     }
 
-    grid_.assign(static_cast<std::size_t>(width_ * height_), '#');
+    allocateCells('#');
 
     for (int y = 0; y < height_; y++) {
         for (int x = 0; x < width_; x++) {
@@ -100,6 +345,7 @@ bool Maze::loadFromFile(const char* filename) {
         }
     }
 
+    rebuildOpenMasks();
     return true;
 }
 
@@ -130,8 +376,7 @@ bool Maze::isValid(const Point& p) const {
 
 bool Maze::isWalkable(const Point& p) const {
     if (!isValid(p)) return false;
-    char cell = getCellAt(p);
-    return cell != '#';
+    return costModel_->isPassable(getCellAt(p));
 }
 
 bool Maze::isStart(const Point& p) const {
@@ -142,25 +387,152 @@ bool Maze::isGoal(const Point& p) const {
     return p == goal_;
 }
 
+bool Maze::hasUniformCosts() const {
+    double cost = -1.0;
+    auto accept = [&](char cell) {
+        if (!costModel_->isPassable(cell)) return true;
+        double c = costModel_->getCost(cell);
+        if (cost < 0.0) {
+            cost = c;
+        }
+        return c == cost;
+    };
+
+    if (storage_ == CellStorage::Bytes) {
+        for (char cell : grid_) {
+            if (!accept(cell)) return false;
+        }
+        return true;
+    }
+
+    // Only the palette entries in use matter.
+    bool used[16] = {};
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            used[getPackedCode(x, y)] = true;
+        }
+    }
+    for (int code = 0; code < paletteSize_; code++) {
+        if (used[code] && !accept(palette_[code])) return false;
+    }
+    return true;
+}
+
+void Maze::buildReachabilityIndex() const {
+    reachability_.ensureBuilt(*this);
+}
+
+std::uint64_t Maze::getRevision() const {
+    return revision_;
+}
+
+bool Maze::hasReachabilityIndex() const {
+    return reachability_.isBuilt();
+}
+
+bool Maze::areConnected(const Point& a, const Point& b) const {
+    if (!isWalkable(a) || !isWalkable(b)) {
+        return false;
+    }
+    buildReachabilityIndex();
+    return reachability_.connected(a.getX(), a.getY(), b.getX(), b.getY());
+}
+
 void Maze::getNeighbors(const Point& p, Point* neighbors, int& count) const {
     count = 0;
 
-    
-    const Point directions[4] = {
-        Point(0, -1),   
-        Point(1, 0),    
-        Point(0, 1),    
-        Point(-1, 0)    
-    };
+    if (isValid(p)) {
+        forEachNeighbor(p, [&](const Point& neighbor) {
+            neighbors[count++] = neighbor;
+        });
+        return;
+    }
 
-    for (const auto& dir : directions) {
-        Point neighbor = p + dir;
+    // Points just outside the grid have no mask but may still touch it.
+    for (int direction = 0; direction < 4; direction++) {
+        Point neighbor(p.getX() + directionDx(direction), p.getY() + directionDy(direction));
         if (isWalkable(neighbor)) {
             neighbors[count++] = neighbor;
         }
     }
 }
 
+void Maze::rebuildOpenMasks() {
+    if (storage_ == CellStorage::Packed) {
+        std::vector<std::uint8_t>().swap(openMasks_);
+        return;
+    }
+
+    openMasks_.assign((cellCount() + 1) / 2, 0);
+    if (width_ == 0 || height_ == 0) {
+        return;
+    }
+
+    // The sentinel border is closed, so the mask pass below has no edge
+    // cases: every neighbour index is valid storage.
+    std::vector<std::uint8_t> open(cellCount(), 0);
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            int cell = cellIndex(x, y);
+            open[static_cast<std::size_t>(cell)] = isWalkableAtIndex(cell) ? 1 : 0;
+        }
+    }
+
+#if defined(MAZE_LAYOUT_TILED)
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            int index = cellIndex(x, y);
+            int mask = 0;
+            for (int direction = 0; direction < 4; direction++) {
+                mask |= open[static_cast<std::size_t>(layout_.neighbor(index, direction))] << direction;
+            }
+            std::size_t cell = static_cast<std::size_t>(index);
+            openMasks_[cell >> 1] = static_cast<std::uint8_t>(openMasks_[cell >> 1] | (mask << ((cell & 1) << 2)));
+        }
+    }
+#else
+    // Row-major rows are contiguous, so the masks reduce to shifts and ors
+    // over whole rows with fixed offsets instead of neighbor() per cell.
+    const std::size_t stride = static_cast<std::size_t>(width_) + 2;
+    std::vector<std::uint8_t> masks(static_cast<std::size_t>(width_));
+    for (int y = 0; y < height_; y++) {
+        std::size_t base = static_cast<std::size_t>(cellIndex(0, y));
+        const std::uint8_t* row = &open[base];
+        const std::uint8_t* above = row - stride;
+        const std::uint8_t* below = row + stride;
+        for (int x = 0; x < width_; x++) {
+            masks[static_cast<std::size_t>(x)] = static_cast<std::uint8_t>(
+                above[x] | (row[x + 1] << 1) | (below[x] << 2) | (row[x - 1] << 3));
+        }
+
+        for (int x = 0; x < width_; x++) {
+            std::size_t cell = base + static_cast<std::size_t>(x);
+            openMasks_[cell >> 1] = static_cast<std::uint8_t>(
+                openMasks_[cell >> 1] | (masks[static_cast<std::size_t>(x)] << ((cell & 1) << 2)));
+        }
+    }
+#endif
+}
+
+void Maze::refreshOpenMasksAround(int x, int y) {
+    if (storage_ == CellStorage::Packed || x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return;
+    }
+
+    bool open = costModel_->isPassable(getCellUnchecked(x, y));
+    for (int direction = 0; direction < 4; direction++) {
+        int nx = x + directionDx(direction);
+        int ny = y + directionDy(direction);
+        if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) continue;
+
+        // The neighbour sees this cell in the opposite direction.
+        std::size_t cell = static_cast<std::size_t>(cellIndex(nx, ny));
+        int bit = 1 << (((direction + 2) & 3) + static_cast<int>((cell & 1) << 2));
+        std::uint8_t& byte = openMasks_[cell >> 1];
+        byte = static_cast<std::uint8_t>(open ? (byte | bit) : (byte & ~bit));
+    }
+}
+
 void Maze::display() const {
     std::cout << "Maze (" << width_ << "x" << height_ << "):\n";
     for (int y = 0; y < height_; y++) {
@@ -3,7 +3,12 @@
 #include <algorithm>
 
 MazeGenerator::MazeGenerator(int width, int height, int seed)
-    : width_(width), height_(height), seed_(seed), visited_(), randomSeed_(seed) {}
+    : width_(width),
+      height_(height),
+      seed_(seed),
+      visited_(),
+      costModel_(CostModel::standard()),
+      randomSeed_(seed) {}
 
 void MazeGenerator::initializeVisited(const Maze& maze) {
     visited_.assign(static_cast<std::size_t>(maze.getWidth() * maze.getHeight()), false);
@@ -75,6 +80,7 @@ Maze MazeGenerator::generatePerfect() {
     int h = (height_ % 2 == 0) ? height_ + 1 : height_;
 
     Maze maze(w, h);
+    maze.setCostModel(costModel_);
 
     for (int y = 0; y < h; y++) {
         for (int x = 0; x < w; x++) {
@@ -119,19 +125,8 @@ Maze MazeGenerator::generateWithLoops(int extraPaths) {
         int y = randomRange(1, mazeHeight - 2);
         Point p(x, y);
 
-        if (maze.getCellAt(p) == '#') {
-            int pathCount = 0;
-            const Point neighbors[4] = {
-                Point(x, y - 1), Point(x + 1, y), Point(x, y + 1), Point(x - 1, y)
-            };
-
-            for (const auto& neighbor : neighbors) {
-                if (maze.getCellAt(neighbor) != '#') {
-                    pathCount++;
-                }
-            }
-
-            if (pathCount >= 2) {
+        if (!maze.isWalkable(p)) {
+            if (maze.getDegree(p) >= 2) {
                 maze.setCellAt(p, '.');
                 added++;
             }
@@ -228,3 +223,7 @@ void MazeGenerator::setDimensions(int width, int height) {
     width_ = width;
     height_ = height;
 }
+
+void MazeGenerator::setCostModel(const std::shared_ptr<const CostModel>& model) {
+    costModel_ = model ? model : CostModel::standard();
+}
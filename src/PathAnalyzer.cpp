@@ -160,13 +160,7 @@ int PathAnalyzer::countNarrowPassages(const Path& path, const Maze& maze) const
     int narrowCount = 0;
     
     for (int i = 0; i < path.getSize(); i++) {
-        Point p = path[i];
-        
-        Point neighbors[4];
-        int neighborCount;
-        maze.getNeighbors(p, neighbors, neighborCount);
-        
-        if (neighborCount <= 2) {
+        if (maze.getDegree(path[i]) <= 2) {
             narrowCount++;
         }
     }
@@ -188,13 +182,7 @@ PathMetrics PathAnalyzer::analyze(const Path& path, const Maze& maze) {
     
     for (int i = 1; i < path.getSize(); ++i) {
         const Point& current = path[i];
-        char cell = maze.getCellAt(current);
-        double cost = 1.0;
-        if (cell == '~') {
-            cost = 2.0;
-        } else if (cell == '^') {
-            cost = 3.0;
-        }
+        double cost = maze.getCellCost(current);
         
         stepCosts.addSample(cost);
         
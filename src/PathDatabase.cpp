@@ -0,0 +1,383 @@
+#include "PathDatabase.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace {
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+    const char kMagic[4] = {'M', 'Z', 'P', 'D'};
+    const std::uint32_t kVersion = 1;
+
+    // A row entry packs the first target index of a run with its 2-bit move.
+    std::uint32_t encodeRun(int target, int move) {
+        return (static_cast<std::uint32_t>(target) << 2) | static_cast<std::uint32_t>(move);
+    }
+
+    // Per-thread scratch space for the single-source searches.
+    class SourceSearch {
+    public:
+        SourceSearch(const std::vector<int>& adjacency, const std::vector<double>& cost, bool uniform)
+            : adjacency_(adjacency), cost_(cost), uniform_(uniform),
+              dist_(cost.size()), first_(cost.size()) {}
+
+        // Fills first_[t] with the direction of the first step on a shortest
+        // path from source to t, or -1 when t is the source or unreachable.
+        void run(int source) {
+            std::fill(dist_.begin(), dist_.end(), -1.0);
+            std::fill(first_.begin(), first_.end(), static_cast<signed char>(-1));
+            dist_[static_cast<std::size_t>(source)] = 0.0;
+
+            if (uniform_) {
+                runBreadthFirst(source);
+            } else {
+                runDijkstra(source);
+            }
+        }
+
+        int firstMove(int target) const {
+            return first_[static_cast<std::size_t>(target)];
+        }
+
+    private:
+        typedef std::pair<double, int> QueueItem;
+
+        const std::vector<int>& adjacency_;
+        const std::vector<double>& cost_;
+        bool uniform_;
+        std::vector<double> dist_;
+        std::vector<signed char> first_;
+        std::vector<int> queue_;
+
+        signed char inherit(int from, int source, int dir) const {
+            return from == source ? static_cast<signed char>(dir) : first_[static_cast<std::size_t>(from)];
+        }
+
+        void runBreadthFirst(int source) {
+            queue_.clear();
+            queue_.push_back(source);
+            for (std::size_t head = 0; head < queue_.size(); head++) {
+                int u = queue_[head];
+                for (int dir = 0; dir < 4; dir++) {
+                    int v = adjacency_[static_cast<std::size_t>(u * 4 + dir)];
+                    if (v < 0 || dist_[static_cast<std::size_t>(v)] >= 0.0) continue;
+                    dist_[static_cast<std::size_t>(v)] = dist_[static_cast<std::size_t>(u)] + 1.0;
+                    first_[static_cast<std::size_t>(v)] = inherit(u, source, dir);
+                    queue_.push_back(v);
+                }
+            }
+        }
+
+        void runDijkstra(int source) {
+            std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> heap;
+            heap.push(QueueItem(0.0, source));
+            while (!heap.empty()) {
+                QueueItem top = heap.top();
+                heap.pop();
+                int u = top.second;
+                if (top.first > dist_[static_cast<std::size_t>(u)]) continue;
+
+                for (int dir = 0; dir < 4; dir++) {
+                    int v = adjacency_[static_cast<std::size_t>(u * 4 + dir)];
+                    if (v < 0) continue;
+                    double candidate = top.first + cost_[static_cast<std::size_t>(v)];
+                    double& current = dist_[static_cast<std::size_t>(v)];
+                    if (current < 0.0 || candidate < current) {
+                        current = candidate;
+                        first_[static_cast<std::size_t>(v)] = inherit(u, source, dir);
+                        heap.push(QueueItem(candidate, v));
+                    }
+                }
+            }
+        }
+    };
+
+    // Targets with no defined move (the source itself, other components)
+    // are never queried, so they extend whichever run they fall in.
+    void compressRow(const SourceSearch& search, int nodes, std::vector<std::uint32_t>& row) {
+        row.clear();
+        int previous = -1;
+        for (int t = 0; t < nodes; t++) {
+            int move = search.firstMove(t);
+            if (move < 0 || move == previous) continue;
+            row.push_back(encodeRun(row.empty() ? 0 : t, move));
+            previous = move;
+        }
+        if (row.empty()) {
+            row.push_back(encodeRun(0, 0));
+        }
+    }
+
+    template <typename T>
+    void writeArray(std::ofstream& file, const std::vector<T>& values) {
+        if (!values.empty()) {
+            file.write(reinterpret_cast<const char*>(values.data()),
+                       static_cast<std::streamsize>(values.size() * sizeof(T)));
+        }
+    }
+
+    template <typename T>
+    bool readArray(std::ifstream& file, std::vector<T>& values, std::size_t count) {
+        values.resize(count);
+        if (count == 0) return true;
+        file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+        return static_cast<bool>(file);
+    }
+}
+
+PathDatabase::PathDatabase() : width_(0), height_(0) {}
+
+int PathDatabase::nodeAt(const Point& p) const {
+    if (p.getX() < 0 || p.getX() >= width_ || p.getY() < 0 || p.getY() >= height_) {
+        return -1;
+    }
+    return cellToNode_[static_cast<std::size_t>(p.getY() * width_ + p.getX())];
+}
+
+// Depth-first preorder keeps corridor neighbours adjacent in the target
+// order, which is what makes the per-source rows compress into few runs.
+void PathDatabase::orderNodes(const Maze& maze) {
+    std::size_t cells = static_cast<std::size_t>(width_ * height_);
+    cellToNode_.assign(cells, -1);
+    nodeToCell_.clear();
+    component_.clear();
+    nodeCost_.clear();
+
+    std::vector<int> stack;
+    int components = 0;
+    for (int start = 0; start < width_ * height_; start++) {
+        if (cellToNode_[static_cast<std::size_t>(start)] != -1) continue;
+        if (!maze.isWalkable(Point(start % width_, start / width_))) continue;
+
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            if (cellToNode_[static_cast<std::size_t>(cell)] != -1) continue;
+
+            Point p(cell % width_, cell / width_);
+            cellToNode_[static_cast<std::size_t>(cell)] = static_cast<int>(nodeToCell_.size());
+            nodeToCell_.push_back(cell);
+            component_.push_back(components);
+            nodeCost_.push_back(maze.getCellCost(p));
+
+            for (int dir = 3; dir >= 0; dir--) {
+                Point next(p.getX() + kDx[dir], p.getY() + kDy[dir]);
+                if (!maze.isWalkable(next)) continue;
+                int nextCell = next.getY() * width_ + next.getX();
+                if (cellToNode_[static_cast<std::size_t>(nextCell)] == -1) {
+                    stack.push_back(nextCell);
+                }
+            }
+        }
+        components++;
+    }
+}
+
+bool PathDatabase::build(const Maze& maze, int threads) {
+    auto started = std::chrono::steady_clock::now();
+    clear();
+
+    width_ = maze.getWidth();
+    height_ = maze.getHeight();
+    orderNodes(maze);
+
+    const int nodes = static_cast<int>(nodeToCell_.size());
+    if (nodes == 0 || nodes >= (1 << 30)) {
+        clear();
+        return false;
+    }
+
+    std::vector<int> adjacency(static_cast<std::size_t>(nodes) * 4, -1);
+    bool uniform = true;
+    for (int n = 0; n < nodes; n++) {
+        int cell = nodeToCell_[static_cast<std::size_t>(n)];
+        for (int dir = 0; dir < 4; dir++) {
+            adjacency[static_cast<std::size_t>(n * 4 + dir)] =
+                nodeAt(Point(cell % width_ + kDx[dir], cell / width_ + kDy[dir]));
+        }
+        uniform = uniform && nodeCost_[static_cast<std::size_t>(n)] == nodeCost_[0];
+    }
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threads = std::max(1, std::min(threads, nodes));
+
+    std::vector<std::vector<std::uint32_t>> rows(static_cast<std::size_t>(nodes));
+    std::atomic<int> nextSource(0);
+    auto worker = [&]() {
+        SourceSearch search(adjacency, nodeCost_, uniform);
+        for (int s = nextSource.fetch_add(1); s < nodes; s = nextSource.fetch_add(1)) {
+            search.run(s);
+            compressRow(search, nodes, rows[static_cast<std::size_t>(s)]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.push_back(std::thread(worker));
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    rowOffsets_.assign(static_cast<std::size_t>(nodes) + 1, 0);
+    for (int s = 0; s < nodes; s++) {
+        const std::vector<std::uint32_t>& row = rows[static_cast<std::size_t>(s)];
+        rowOffsets_[static_cast<std::size_t>(s) + 1] =
+            rowOffsets_[static_cast<std::size_t>(s)] + static_cast<std::uint32_t>(row.size());
+        runs_.insert(runs_.end(), row.begin(), row.end());
+        std::vector<std::uint32_t>().swap(rows[static_cast<std::size_t>(s)]);
+    }
+
+    stats_.threads = threads;
+    stats_.buildMillis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started).count();
+    updateSizeStats();
+    return true;
+}
+
+void PathDatabase::updateSizeStats() {
+    std::size_t nodes = nodeToCell_.size();
+    stats_.nodes = static_cast<int>(nodes);
+    stats_.runs = static_cast<long long>(runs_.size());
+    stats_.compressedBytes = runs_.size() * sizeof(std::uint32_t) +
+                             rowOffsets_.size() * sizeof(std::uint32_t);
+    stats_.uncompressedBytes = (nodes * nodes + 3) / 4;
+}
+
+bool PathDatabase::isBuilt() const {
+    return !rowOffsets_.empty();
+}
+
+void PathDatabase::clear() {
+    width_ = 0;
+    height_ = 0;
+    cellToNode_.clear();
+    nodeToCell_.clear();
+    component_.clear();
+    nodeCost_.clear();
+    rowOffsets_.clear();
+    runs_.clear();
+    stats_ = PathDatabaseStats();
+}
+
+bool PathDatabase::saveToFile(const char* filename) const {
+    if (!isBuilt()) {
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::int32_t header[4] = {
+        width_, height_, static_cast<std::int32_t>(nodeToCell_.size()), static_cast<std::int32_t>(runs_.size())
+    };
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    writeArray(file, nodeToCell_);
+    writeArray(file, component_);
+    writeArray(file, nodeCost_);
+    writeArray(file, rowOffsets_);
+    writeArray(file, runs_);
+    return static_cast<bool>(file);
+}
+
+bool PathDatabase::loadFromFile(const char* filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::int32_t header[4];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion ||
+        header[0] <= 0 || header[1] <= 0 || header[2] <= 0 || header[3] <= 0) {
+        return false;
+    }
+
+    clear();
+    width_ = header[0];
+    height_ = header[1];
+    std::size_t nodes = static_cast<std::size_t>(header[2]);
+
+    bool ok = readArray(file, nodeToCell_, nodes) &&
+              readArray(file, component_, nodes) &&
+              readArray(file, nodeCost_, nodes) &&
+              readArray(file, rowOffsets_, nodes + 1) &&
+              readArray(file, runs_, static_cast<std::size_t>(header[3]));
+    if (!ok || rowOffsets_.back() != runs_.size()) {
+        clear();
+        return false;
+    }
+
+    cellToNode_.assign(static_cast<std::size_t>(width_ * height_), -1);
+    for (std::size_t n = 0; n < nodes; n++) {
+        int cell = nodeToCell_[n];
+        if (cell < 0 || cell >= width_ * height_) {
+            clear();
+            return false;
+        }
+        cellToNode_[static_cast<std::size_t>(cell)] = static_cast<int>(n);
+    }
+
+    updateSizeStats();
+    return true;
+}
+
+int PathDatabase::getFirstMove(const Point& from, const Point& to) const {
+    int source = nodeAt(from);
+    int target = nodeAt(to);
+    if (source < 0 || target < 0 || source == target ||
+        component_[static_cast<std::size_t>(source)] != component_[static_cast<std::size_t>(target)]) {
+        return -1;
+    }
+
+    auto begin = runs_.begin() + rowOffsets_[static_cast<std::size_t>(source)];
+    auto end = runs_.begin() + rowOffsets_[static_cast<std::size_t>(source) + 1];
+    auto run = std::upper_bound(begin, end, encodeRun(target, 3)) - 1;
+    return static_cast<int>(*run & 3u);
+}
+
+Path PathDatabase::getPath(const Point& from, const Point& to) const {
+    Path path;
+    int target = nodeAt(to);
+    if (nodeAt(from) < 0 || target < 0) {
+        return path;
+    }
+    if (from != to && getFirstMove(from, to) < 0) {
+        return path;
+    }
+
+    double cost = 0.0;
+    Point current = from;
+    path.addPoint(current);
+    while (current != to) {
+        int move = getFirstMove(current, to);
+        current = Point(current.getX() + kDx[move], current.getY() + kDy[move]);
+        cost += nodeCost_[static_cast<std::size_t>(nodeAt(current))];
+        path.addPoint(current);
+    }
+    path.setCost(cost);
+    return path;
+}
+
+const PathDatabaseStats& PathDatabase::getStats() const {
+    return stats_;
+}
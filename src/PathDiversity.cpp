@@ -0,0 +1,240 @@
+#include "PathDiversity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace {
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+    const double kInfinity = std::numeric_limits<double>::infinity();
+
+    bool sameCost(double a, double b) {
+        return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(a));
+    }
+
+    typedef std::pair<double, int> QueueItem;
+}
+
+PathDiversity::PathDiversity()
+    : reachable_(false),
+      shortestCost_(0.0),
+      pathCount_(0),
+      saturated_(false),
+      cellsOnShortestPaths_(0),
+      mandatoryCells_(0),
+      decisionCells_(0),
+      width_(0),
+      onShortestPath_() {}
+
+bool PathDiversity::isReachable() const {
+    return reachable_;
+}
+
+double PathDiversity::getShortestCost() const {
+    return shortestCost_;
+}
+
+std::uint64_t PathDiversity::getPathCount() const {
+    return pathCount_;
+}
+
+bool PathDiversity::isSaturated() const {
+    return saturated_;
+}
+
+int PathDiversity::getCellsOnShortestPaths() const {
+    return cellsOnShortestPaths_;
+}
+
+int PathDiversity::getMandatoryCells() const {
+    return mandatoryCells_;
+}
+
+int PathDiversity::getDecisionCells() const {
+    return decisionCells_;
+}
+
+bool PathDiversity::isOnShortestPath(const Point& p) const {
+    if (width_ == 0 || p.getX() < 0 || p.getX() >= width_ || p.getY() < 0) {
+        return false;
+    }
+    std::size_t cell = static_cast<std::size_t>(p.getY() * width_ + p.getX());
+    return cell < onShortestPath_.size() && onShortestPath_[cell];
+}
+
+void PathDiversity::display() const {
+    std::cout << *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const PathDiversity& d) {
+    if (!d.reachable_) {
+        os << "Path diversity: goal unreachable\n";
+        return os;
+    }
+    os << "Shortest cost:           " << d.shortestCost_ << "\n"
+       << "Shortest paths:          " << d.pathCount_ << (d.saturated_ ? "+ (saturated)" : "") << "\n"
+       << "Cells on shortest paths: " << d.cellsOnShortestPaths_ << "\n"
+       << "Mandatory cells:         " << d.mandatoryCells_ << "\n"
+       << "Decision cells:          " << d.decisionCells_ << "\n";
+    return os;
+}
+
+PathDiversityAnalyzer::PathDiversityAnalyzer() : mode_(PathCountMode::Saturating), parallel_(false) {}
+
+void PathDiversityAnalyzer::setMode(PathCountMode mode) {
+    mode_ = mode;
+}
+
+void PathDiversityAnalyzer::setParallel(bool parallel) {
+    parallel_ = parallel;
+}
+
+PathCountMode PathDiversityAnalyzer::getMode() const {
+    return mode_;
+}
+
+bool PathDiversityAnalyzer::isParallel() const {
+    return parallel_;
+}
+
+std::uint64_t PathDiversityAnalyzer::add(std::uint64_t a, std::uint64_t b, bool& saturated) const {
+    std::uint64_t sum = a + b;
+    if (sum < a) {
+        saturated = true;
+        return mode_ == PathCountMode::Saturating ? std::numeric_limits<std::uint64_t>::max() : sum;
+    }
+    return sum;
+}
+
+// One pass of a counting search. Forward passes measure the cost from the
+// source; backward passes measure the cost to reach the source, which is
+// the same walk with the entered cell's cost charged on the other end.
+// Costs are positive, so a cell's count is final by the time it is settled.
+void PathDiversityAnalyzer::sweep(const Maze& maze, const Point& source, bool forward, bool uniform,
+                                  Sweep& out) const {
+    const int width = maze.getWidth();
+    const std::size_t cells = static_cast<std::size_t>(width * maze.getHeight());
+    out.distance.assign(cells, kInfinity);
+    out.count.assign(cells, 0);
+    out.saturated = false;
+
+    const int sourceCell = source.getY() * width + source.getX();
+    out.distance[static_cast<std::size_t>(sourceCell)] = 0.0;
+    out.count[static_cast<std::size_t>(sourceCell)] = 1;
+
+    std::vector<int> improved;
+    auto relaxAll = [&](int u, double du) {
+        improved.clear();
+        Point p(u % width, u / width);
+        double leaveCost = forward ? 0.0 : maze.getCellCost(p);
+        for (int dir = 0; dir < 4; dir++) {
+            Point next(p.getX() + kDx[dir], p.getY() + kDy[dir]);
+            if (!maze.isWalkable(next)) continue;
+
+            int v = next.getY() * width + next.getX();
+            double candidate = du + (forward ? maze.getCellCost(next) : leaveCost);
+            double& dv = out.distance[static_cast<std::size_t>(v)];
+            std::uint64_t& cv = out.count[static_cast<std::size_t>(v)];
+            if (dv == kInfinity || (candidate < dv && !sameCost(candidate, dv))) {
+                dv = candidate;
+                cv = out.count[static_cast<std::size_t>(u)];
+                improved.push_back(v);
+            } else if (sameCost(candidate, dv)) {
+                cv = add(cv, out.count[static_cast<std::size_t>(u)], out.saturated);
+            }
+        }
+    };
+
+    if (uniform) {
+        std::vector<int> queue(1, sourceCell);
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            int u = queue[head];
+            relaxAll(u, out.distance[static_cast<std::size_t>(u)]);
+            queue.insert(queue.end(), improved.begin(), improved.end());
+        }
+        return;
+    }
+
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> heap;
+    heap.push(QueueItem(0.0, sourceCell));
+    while (!heap.empty()) {
+        QueueItem top = heap.top();
+        heap.pop();
+        if (top.first > out.distance[static_cast<std::size_t>(top.second)]) continue;
+        relaxAll(top.second, top.first);
+        for (int v : improved) {
+            heap.push(QueueItem(out.distance[static_cast<std::size_t>(v)], v));
+        }
+    }
+}
+
+PathDiversity PathDiversityAnalyzer::analyze(const Maze& maze) const {
+    PathDiversity result;
+    Point start = maze.getStart();
+    Point goal = maze.getGoal();
+    if (!maze.areConnected(start, goal)) {
+        return result;
+    }
+
+    const bool uniform = maze.hasUniformCosts();
+    Sweep forward;
+    Sweep backward;
+    if (parallel_) {
+        std::thread worker([&]() { sweep(maze, goal, false, uniform, backward); });
+        sweep(maze, start, true, uniform, forward);
+        worker.join();
+    } else {
+        sweep(maze, start, true, uniform, forward);
+        sweep(maze, goal, false, uniform, backward);
+    }
+
+    const int width = maze.getWidth();
+    const std::size_t cells = forward.distance.size();
+    const std::size_t goalCell = static_cast<std::size_t>(goal.getY() * width + goal.getX());
+    const double shortest = forward.distance[goalCell];
+
+    result.reachable_ = true;
+    result.width_ = width;
+    result.shortestCost_ = shortest;
+    result.pathCount_ = forward.count[goalCell];
+    result.saturated_ = forward.saturated || backward.saturated;
+    result.onShortestPath_.assign(cells, false);
+
+    for (std::size_t c = 0; c < cells; c++) {
+        double through = forward.distance[c] + backward.distance[c];
+        if (through == kInfinity || !sameCost(through, shortest)) continue;
+        result.onShortestPath_[c] = true;
+        result.cellsOnShortestPaths_++;
+    }
+
+    // A cell lies on every shortest path when the paths through it account
+    // for all of them; a decision cell has more than one shortest way on.
+    for (std::size_t c = 0; c < cells; c++) {
+        if (!result.onShortestPath_[c]) continue;
+
+        if (!result.saturated_) {
+            std::uint64_t through = forward.count[c] * backward.count[c];
+            if (through == result.pathCount_) result.mandatoryCells_++;
+        }
+
+        int x = static_cast<int>(c) % width;
+        int y = static_cast<int>(c) / width;
+        int successors = 0;
+        for (int dir = 0; dir < 4; dir++) {
+            Point next(x + kDx[dir], y + kDy[dir]);
+            if (!maze.isWalkable(next)) continue;
+            std::size_t n = static_cast<std::size_t>(next.getY() * width + next.getX());
+            if (result.onShortestPath_[n] &&
+                sameCost(forward.distance[c] + maze.getCellCost(next), forward.distance[n])) {
+                successors++;
+            }
+        }
+        if (successors > 1) result.decisionCells_++;
+    }
+    return result;
+}
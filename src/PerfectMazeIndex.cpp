@@ -0,0 +1,339 @@
+#include "PerfectMazeIndex.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+}
+
+PerfectMazeIndex::PerfectMazeIndex() : width_(0), height_(0), nodeCount_(0), built_(false) {}
+
+bool PerfectMazeIndex::isTree(const Maze& maze) {
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    long long cells = 0;
+    long long edges = 0;
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!maze.isWalkable(Point(x, y))) continue;
+            cells++;
+            int mask = maze.getOpenMask(x, y);
+            if (mask & 2) edges++;
+            if (mask & 4) edges++;
+        }
+    }
+
+    std::vector<bool> seen(static_cast<std::size_t>(width * height), false);
+    std::vector<int> stack;
+    long long components = 0;
+
+    for (int start = 0; start < width * height; start++) {
+        Point p(start % width, start / width);
+        if (seen[static_cast<std::size_t>(start)] || !maze.isWalkable(p)) continue;
+
+        components++;
+        seen[static_cast<std::size_t>(start)] = true;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+
+            Point neighbors[4];
+            int count;
+            maze.getNeighbors(Point(cell % width, cell / width), neighbors, count);
+            for (int i = 0; i < count; i++) {
+                int next = neighbors[i].getY() * width + neighbors[i].getX();
+                if (!seen[static_cast<std::size_t>(next)]) {
+                    seen[static_cast<std::size_t>(next)] = true;
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+
+    return edges == cells - components;
+}
+
+void PerfectMazeIndex::clear() {
+    width_ = 0;
+    height_ = 0;
+    nodeCount_ = 0;
+    built_ = false;
+    nodeOfCell_.clear();
+    cellOfNode_.clear();
+    parent_.clear();
+    depth_.clear();
+    costDepth_.clear();
+    cellCost_.clear();
+    component_.clear();
+    preorder_.clear();
+    position_.clear();
+    sparse_.clear();
+    log2_.clear();
+}
+
+bool PerfectMazeIndex::build(const Maze& maze, SolveBudget* budget) {
+    clear();
+    width_ = maze.getWidth();
+    height_ = maze.getHeight();
+
+    nodeOfCell_.assign(static_cast<std::size_t>(width_ * height_), -1);
+    for (int y = 0; y < height_; y++) {
+        if (budget && !budget->poll()) {
+            clear();
+            return false;
+        }
+        for (int x = 0; x < width_; x++) {
+            Point p(x, y);
+            if (maze.isWalkable(p)) {
+                nodeOfCell_[static_cast<std::size_t>(y * width_ + x)] = nodeCount_++;
+                cellOfNode_.push_back(y * width_ + x);
+                cellCost_.push_back(maze.getCellCost(p));
+            }
+        }
+    }
+
+    std::size_t n = static_cast<std::size_t>(nodeCount_);
+    parent_.assign(n, -1);
+    depth_.assign(n, 0);
+    costDepth_.assign(n, 0.0);
+    component_.assign(n, -1);
+    position_.assign(n, 0);
+    preorder_.reserve(n);
+
+    std::vector<std::pair<int, int>> stack;
+    int componentCount = 0;
+
+    for (int root = 0; root < nodeCount_; root++) {
+        if (component_[static_cast<std::size_t>(root)] != -1) continue;
+
+        component_[static_cast<std::size_t>(root)] = componentCount;
+        costDepth_[static_cast<std::size_t>(root)] = cellCost_[static_cast<std::size_t>(root)];
+        position_[static_cast<std::size_t>(root)] = static_cast<int>(preorder_.size());
+        preorder_.push_back(root);
+        stack.push_back(std::make_pair(root, 0));
+
+        while (!stack.empty()) {
+            int node = stack.back().first;
+            int dir = stack.back().second;
+            if (dir == 4) {
+                stack.pop_back();
+                continue;
+            }
+            stack.back().second++;
+
+            int cell = cellOfNode_[static_cast<std::size_t>(node)];
+            int nx = cell % width_ + kDx[dir];
+            int ny = cell / width_ + kDy[dir];
+            if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) continue;
+
+            int next = nodeOfCell_[static_cast<std::size_t>(ny * width_ + nx)];
+            if (next == -1 || next == parent_[static_cast<std::size_t>(node)]) continue;
+
+            if (component_[static_cast<std::size_t>(next)] != -1 || (budget && !budget->consume())) {
+                clear();
+                return false;
+            }
+
+            std::size_t idx = static_cast<std::size_t>(next);
+            parent_[idx] = node;
+            depth_[idx] = depth_[static_cast<std::size_t>(node)] + 1;
+            costDepth_[idx] = costDepth_[static_cast<std::size_t>(node)] + cellCost_[idx];
+            component_[idx] = componentCount;
+            position_[idx] = static_cast<int>(preorder_.size());
+            preorder_.push_back(next);
+            stack.push_back(std::make_pair(next, 0));
+        }
+
+        componentCount++;
+    }
+
+    if (!buildSparseTable(budget)) {
+        clear();
+        return false;
+    }
+    built_ = true;
+    return true;
+}
+
+int PerfectMazeIndex::shallower(int a, int b) const {
+    return depth_[static_cast<std::size_t>(a)] <= depth_[static_cast<std::size_t>(b)] ? a : b;
+}
+
+bool PerfectMazeIndex::buildSparseTable(SolveBudget* budget) {
+    std::size_t n = static_cast<std::size_t>(nodeCount_);
+    log2_.assign(n + 1, 0);
+    for (std::size_t i = 2; i <= n; i++) {
+        log2_[i] = log2_[i / 2] + 1;
+    }
+
+    int levels = n > 0 ? log2_[n] + 1 : 0;
+    sparse_.assign(static_cast<std::size_t>(levels) * n, 0);
+    std::copy(preorder_.begin(), preorder_.end(), sparse_.begin());
+
+    for (int k = 1; k < levels; k++) {
+        if (budget && !budget->poll()) {
+            return false;
+        }
+        std::size_t span = static_cast<std::size_t>(1) << k;
+        std::size_t half = span / 2;
+        std::size_t row = static_cast<std::size_t>(k) * n;
+        std::size_t prev = row - n;
+        for (std::size_t i = 0; i + span <= n; i++) {
+            sparse_[row + i] = shallower(sparse_[prev + i], sparse_[prev + i + half]);
+        }
+    }
+    return true;
+}
+
+int PerfectMazeIndex::nodeAt(const Point& p) const {
+    if (!built_ || p.getX() < 0 || p.getX() >= width_ || p.getY() < 0 || p.getY() >= height_) {
+        return -1;
+    }
+    return nodeOfCell_[static_cast<std::size_t>(p.getY() * width_ + p.getX())];
+}
+
+Point PerfectMazeIndex::pointOf(int node) const {
+    int cell = cellOfNode_[static_cast<std::size_t>(node)];
+    return Point(cell % width_, cell / width_);
+}
+
+// In preorder, the shallowest node strictly after a and up to b is a child
+// of their lowest common ancestor.
+int PerfectMazeIndex::lowestCommonAncestor(int a, int b) const {
+    if (a == b) return a;
+
+    int left = position_[static_cast<std::size_t>(a)];
+    int right = position_[static_cast<std::size_t>(b)];
+    if (left > right) std::swap(left, right);
+    left++;
+
+    int k = log2_[static_cast<std::size_t>(right - left + 1)];
+    std::size_t row = static_cast<std::size_t>(k) * static_cast<std::size_t>(nodeCount_);
+    int child = shallower(sparse_[row + static_cast<std::size_t>(left)],
+                          sparse_[row + static_cast<std::size_t>(right - (1 << k) + 1)]);
+    return parent_[static_cast<std::size_t>(child)];
+}
+
+bool PerfectMazeIndex::isBuilt() const {
+    return built_;
+}
+
+bool PerfectMazeIndex::connected(const Point& a, const Point& b) const {
+    int u = nodeAt(a);
+    int v = nodeAt(b);
+    return u != -1 && v != -1 &&
+           component_[static_cast<std::size_t>(u)] == component_[static_cast<std::size_t>(v)];
+}
+
+int PerfectMazeIndex::getDistance(const Point& a, const Point& b) const {
+    if (!connected(a, b)) return -1;
+
+    int u = nodeAt(a);
+    int v = nodeAt(b);
+    int l = lowestCommonAncestor(u, v);
+    return depth_[static_cast<std::size_t>(u)] + depth_[static_cast<std::size_t>(v)] -
+           2 * depth_[static_cast<std::size_t>(l)];
+}
+
+double PerfectMazeIndex::getCost(const Point& a, const Point& b) const {
+    if (!connected(a, b)) return -1.0;
+
+    std::size_t u = static_cast<std::size_t>(nodeAt(a));
+    std::size_t v = static_cast<std::size_t>(nodeAt(b));
+    std::size_t l = static_cast<std::size_t>(lowestCommonAncestor(static_cast<int>(u), static_cast<int>(v)));
+
+    // Steps pay for the cell they enter: everything on the path except a.
+    return costDepth_[u] + costDepth_[v] - 2.0 * costDepth_[l] - cellCost_[u] + cellCost_[l];
+}
+
+Point PerfectMazeIndex::getMeetingPoint(const Point& a, const Point& b) const {
+    if (!connected(a, b)) return Point(-1, -1);
+    return pointOf(lowestCommonAncestor(nodeAt(a), nodeAt(b)));
+}
+
+Path PerfectMazeIndex::getPath(const Point& a, const Point& b) const {
+    Path path;
+    if (!connected(a, b)) return path;
+
+    int u = nodeAt(a);
+    int v = nodeAt(b);
+    int l = lowestCommonAncestor(u, v);
+
+    for (int node = u; node != l; node = parent_[static_cast<std::size_t>(node)]) {
+        path.addPoint(pointOf(node));
+    }
+    path.addPoint(pointOf(l));
+
+    std::vector<int> descent;
+    for (int node = v; node != l; node = parent_[static_cast<std::size_t>(node)]) {
+        descent.push_back(node);
+    }
+    for (auto it = descent.rbegin(); it != descent.rend(); ++it) {
+        path.addPoint(pointOf(*it));
+    }
+
+    path.setCost(getCost(a, b));
+    return path;
+}
+
+TreeIndexSolver::TreeIndexSolver()
+    : index_(), fallback_(), revision_(0), cached_(false), nodesExplored_(0), usedFallback_(false) {}
+
+SolveResult TreeIndexSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
+    nodesExplored_ = 0;
+    usedFallback_ = false;
+
+    SolveBudget budget(options);
+    if (!budget.poll()) {
+        return SolveResult(budget.getStopStatus());
+    }
+
+    // The tree path ignores an allowed-cells mask; Dijkstra honours it.
+    if (options.hasAllowedCells()) {
+        usedFallback_ = true;
+        SolveResult result = fallback_.solveWithOptions(maze, options);
+        nodesExplored_ = fallback_.getNodesExplored();
+        return result;
+    }
+
+    if (!cached_ || revision_ != maze.getRevision()) {
+        cached_ = false;
+        bool built = index_.build(maze, &budget);
+        nodesExplored_ = static_cast<int>(budget.getNodesConsumed());
+        if (!built && budget.getStopStatus() != SolveStatus::Found) {
+            return SolveResult(budget.getStopStatus());
+        }
+        revision_ = maze.getRevision();
+        cached_ = true;
+    }
+
+    if (!index_.isBuilt()) {
+        usedFallback_ = true;
+        SolveResult result = fallback_.solveWithOptions(maze, options);
+        nodesExplored_ = fallback_.getNodesExplored();
+        return result;
+    }
+
+    Path path = index_.getPath(maze.getStart(), maze.getGoal());
+    if (path.isEmpty()) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+    nodesExplored_ = std::max(nodesExplored_, path.getSize());
+    return SolveResult(SolveStatus::Found, path);
+}
+
+int TreeIndexSolver::getNodesExplored() const {
+    return nodesExplored_;
+}
+
+std::string TreeIndexSolver::name() const {
+    return "Tree Index (Perfect Maze)";
+}
+
+bool TreeIndexSolver::usedFallback() const {
+    return usedFallback_;
+}
@@ -0,0 +1,195 @@
+#include "PortfolioRunner.h"
+
+#include "Exceptions.h"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <iomanip>
+#include <mutex>
+
+namespace {
+    // Completion order reported by the pool callbacks.
+    struct RaceState {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<int> finished;
+    };
+
+    const std::chrono::milliseconds kCancelPollInterval(20);
+
+    bool isDecisive(const PortfolioEntry& entry) {
+        if (!entry.finished) {
+            return false;
+        }
+        SolveStatus status = entry.result.getStatus();
+        return status == SolveStatus::Found || status == SolveStatus::Unreachable;
+    }
+
+    void collect(const SolveHandle& handle, PortfolioEntry& entry) {
+        entry.finished = true;
+        entry.nodesExplored = handle.getNodesExplored();
+        entry.elapsedMillis = handle.getElapsedMillis();
+        try {
+            entry.result = handle.getResult();
+        } catch (const std::exception&) {
+            // A throwing strategy simply drops out of the race.
+            entry.finished = false;
+            entry.result = SolveResult(SolveStatus::Cancelled);
+        }
+    }
+}
+
+PortfolioResult::PortfolioResult() : entries_(), winner_(-1), wallMillis_(0.0) {}
+
+bool PortfolioResult::hasWinner() const {
+    return winner_ >= 0;
+}
+
+const PortfolioEntry& PortfolioResult::getWinner() const {
+    if (winner_ < 0) {
+        throw AnalysisException("Portfolio run produced no decisive result");
+    }
+    return entries_[static_cast<std::size_t>(winner_)];
+}
+
+int PortfolioResult::getWinnerIndex() const {
+    return winner_;
+}
+
+const std::vector<PortfolioEntry>& PortfolioResult::getEntries() const {
+    return entries_;
+}
+
+double PortfolioResult::getWallMillis() const {
+    return wallMillis_;
+}
+
+void PortfolioResult::display() const {
+    std::cout << *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const PortfolioResult& result) {
+    for (std::size_t i = 0; i < result.entries_.size(); i++) {
+        const PortfolioEntry& entry = result.entries_[i];
+        os << (static_cast<int>(i) == result.winner_ ? "* " : "  ")
+           << std::left << std::setw(34) << entry.name << std::right;
+        if (!entry.finished) {
+            os << "  did not finish\n";
+            continue;
+        }
+        os << std::setw(10) << std::fixed << std::setprecision(3) << entry.elapsedMillis << " ms"
+           << std::setw(10) << entry.nodesExplored << " nodes  "
+           << solveStatusName(entry.result.getStatus()) << "\n";
+        os.unsetf(std::ios_base::floatfield);
+    }
+    os << "  wall time " << std::fixed << std::setprecision(3) << result.wallMillis_ << " ms\n";
+    os.unsetf(std::ios_base::floatfield);
+    return os;
+}
+
+PortfolioRunner::PortfolioRunner(SolverPool& pool)
+    : pool_(pool), mode_(PortfolioMode::FirstResult), factories_() {}
+
+void PortfolioRunner::setMode(PortfolioMode mode) {
+    mode_ = mode;
+}
+
+PortfolioMode PortfolioRunner::getMode() const {
+    return mode_;
+}
+
+void PortfolioRunner::addStrategy(const Factory& factory) {
+    factories_.push_back(factory);
+}
+
+void PortfolioRunner::addEngine(SolverEngine engine) {
+    factories_.push_back([engine] { return createSolver(engine); });
+}
+
+void PortfolioRunner::addEngines(const std::vector<SolverEngine>& engines) {
+    for (SolverEngine engine : engines) {
+        addEngine(engine);
+    }
+}
+
+void PortfolioRunner::clear() {
+    factories_.clear();
+}
+
+int PortfolioRunner::getStrategyCount() const {
+    return static_cast<int>(factories_.size());
+}
+
+PortfolioResult PortfolioRunner::run(const Maze& maze, const SolveOptions& options) const {
+    return run(std::make_shared<const Maze>(maze), options);
+}
+
+PortfolioResult PortfolioRunner::run(const std::shared_ptr<const Maze>& snapshot,
+                                     const SolveOptions& options) const {
+    PortfolioResult outcome;
+    if (factories_.empty() || !snapshot) {
+        return outcome;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    std::shared_ptr<RaceState> state = std::make_shared<RaceState>();
+
+    // One race-wide token lets the winner stop everyone else; a caller token
+    // is forwarded to it while waiting.
+    CancellationToken raceToken;
+    SolveOptions jobOptions = options;
+    jobOptions.setCancellationToken(raceToken);
+    const bool forwardCancel = options.hasCancellationToken();
+    if (forwardCancel && options.getCancellationToken().isCancelled()) {
+        raceToken.cancel();
+    }
+
+    const std::size_t count = factories_.size();
+    std::vector<SolveHandle> handles;
+    handles.reserve(count);
+    outcome.entries_.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        int index = static_cast<int>(i);
+        handles.push_back(pool_.submit(snapshot, factories_[i](), jobOptions, [state, index] {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished.push_back(index);
+            state->changed.notify_all();
+        }));
+        outcome.entries_[i].name = handles.back().getStrategyName();
+    }
+
+    std::size_t seen = 0;
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (true) {
+            while (seen < state->finished.size()) {
+                std::size_t index = static_cast<std::size_t>(state->finished[seen++]);
+                collect(handles[index], outcome.entries_[index]);
+                if (outcome.winner_ < 0 && isDecisive(outcome.entries_[index])) {
+                    outcome.winner_ = static_cast<int>(index);
+                }
+            }
+
+            if (seen == count || (mode_ == PortfolioMode::FirstResult && outcome.winner_ >= 0)) {
+                break;
+            }
+
+            state->changed.wait_for(lock, kCancelPollInterval);
+            if (forwardCancel && options.getCancellationToken().isCancelled()) {
+                raceToken.cancel();
+            }
+        }
+    }
+
+    if (seen < count) {
+        raceToken.cancel();
+        for (std::size_t i = 0; i < count; i++) {
+            if (!outcome.entries_[i].finished) {
+                outcome.entries_[i].result = SolveResult(SolveStatus::Cancelled);
+            }
+        }
+    }
+
+    outcome.wallMillis_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return outcome;
+}
@@ -0,0 +1,165 @@
+#include "ReachabilityIndex.h"
+#include "Maze.h"
+
+#include <utility>
+
+ReachabilityIndex::ReachabilityIndex()
+    : parent_(), componentSize_(), width_(0), height_(0), built_(false), buildMutex_() {}
+
+ReachabilityIndex::ReachabilityIndex(const ReachabilityIndex& other)
+    : parent_(), componentSize_(), width_(0), height_(0), built_(false), buildMutex_() {
+    *this = other;
+}
+
+ReachabilityIndex::ReachabilityIndex(ReachabilityIndex&& other) noexcept
+    : parent_(std::move(other.parent_)),
+      componentSize_(std::move(other.componentSize_)),
+      width_(other.width_),
+      height_(other.height_),
+      built_(other.built_.load()),
+      buildMutex_() {
+    other.built_ = false;
+}
+
+ReachabilityIndex& ReachabilityIndex::operator=(const ReachabilityIndex& other) {
+    if (this == &other) {
+        return *this;
+    }
+    // The source may be mid-build on another thread.
+    std::lock_guard<std::mutex> lock(other.buildMutex_);
+    parent_ = other.parent_;
+    componentSize_ = other.componentSize_;
+    width_ = other.width_;
+    height_ = other.height_;
+    built_ = other.built_.load();
+    return *this;
+}
+
+ReachabilityIndex& ReachabilityIndex::operator=(ReachabilityIndex&& other) noexcept {
+    parent_ = std::move(other.parent_);
+    componentSize_ = std::move(other.componentSize_);
+    width_ = other.width_;
+    height_ = other.height_;
+    built_ = other.built_.load();
+    other.built_ = false;
+    return *this;
+}
+
+int ReachabilityIndex::index(int x, int y) const {
+    return y * width_ + x;
+}
+
+int ReachabilityIndex::findRoot(int cell) const {
+    while (parent_[static_cast<std::size_t>(cell)] != cell) {
+        cell = parent_[static_cast<std::size_t>(cell)];
+    }
+    return cell;
+}
+
+int ReachabilityIndex::findAndCompress(int cell) {
+    int root = findRoot(cell);
+    while (parent_[static_cast<std::size_t>(cell)] != root) {
+        int next = parent_[static_cast<std::size_t>(cell)];
+        parent_[static_cast<std::size_t>(cell)] = root;
+        cell = next;
+    }
+    return root;
+}
+
+void ReachabilityIndex::unite(int a, int b) {
+    int rootA = findAndCompress(a);
+    int rootB = findAndCompress(b);
+    if (rootA == rootB) {
+        return;
+    }
+
+    if (componentSize_[static_cast<std::size_t>(rootA)] < componentSize_[static_cast<std::size_t>(rootB)]) {
+        std::swap(rootA, rootB);
+    }
+    parent_[static_cast<std::size_t>(rootB)] = rootA;
+    componentSize_[static_cast<std::size_t>(rootA)] += componentSize_[static_cast<std::size_t>(rootB)];
+}
+
+void ReachabilityIndex::flatten() {
+    for (std::size_t i = 0; i < parent_.size(); i++) {
+        findAndCompress(static_cast<int>(i));
+    }
+}
+
+void ReachabilityIndex::build(const Maze& maze) {
+    width_ = maze.getWidth();
+    height_ = maze.getHeight();
+
+    std::size_t cellCount = static_cast<std::size_t>(width_ * height_);
+    parent_.resize(cellCount);
+    componentSize_.assign(cellCount, 1);
+    for (std::size_t i = 0; i < cellCount; i++) {
+        parent_[i] = static_cast<int>(i);
+    }
+
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            if (!maze.isWalkable(Point(x, y))) {
+                continue;
+            }
+            if (x + 1 < width_ && maze.isWalkable(Point(x + 1, y))) {
+                unite(index(x, y), index(x + 1, y));
+            }
+            if (y + 1 < height_ && maze.isWalkable(Point(x, y + 1))) {
+                unite(index(x, y), index(x, y + 1));
+            }
+        }
+    }
+
+    // Every cell points straight at its root afterwards, so queries can stay
+    // read-only and never need path compression.
+    flatten();
+    built_.store(true, std::memory_order_release);
+}
+
+void ReachabilityIndex::ensureBuilt(const Maze& maze) {
+    if (built_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(buildMutex_);
+    if (!built_.load(std::memory_order_relaxed)) {
+        build(maze);
+    }
+}
+
+void ReachabilityIndex::invalidate() {
+    built_ = false;
+}
+
+bool ReachabilityIndex::isBuilt() const {
+    return built_;
+}
+
+void ReachabilityIndex::openCell(const Maze& maze, int x, int y) {
+    if (!built_ || x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return;
+    }
+
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+
+    for (int i = 0; i < 4; i++) {
+        int nx = x + dx[i];
+        int ny = y + dy[i];
+        if (nx >= 0 && nx < width_ && ny >= 0 && ny < height_ && maze.isWalkable(Point(nx, ny))) {
+            unite(index(x, y), index(nx, ny));
+        }
+    }
+}
+
+int ReachabilityIndex::getComponent(int x, int y) const {
+    if (!built_ || x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return -1;
+    }
+    return findRoot(index(x, y));
+}
+
+bool ReachabilityIndex::connected(int x1, int y1, int x2, int y2) const {
+    int a = getComponent(x1, y1);
+    return a != -1 && a == getComponent(x2, y2);
+}
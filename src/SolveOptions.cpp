@@ -0,0 +1,129 @@
+#include "SolveOptions.h"
+
+std::string solveStatusName(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::Found:
+            return "found";
+        case SolveStatus::Unreachable:
+            return "unreachable";
+        case SolveStatus::BudgetExceeded:
+            return "budget exceeded";
+        case SolveStatus::Cancelled:
+            return "cancelled";
+        case SolveStatus::Unsupported:
+            return "unsupported";
+    }
+    return "unknown";
+}
+
+CancellationToken::CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+void CancellationToken::cancel() {
+    flag_->store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const {
+    return flag_->load(std::memory_order_relaxed);
+}
+
+SolveOptions::SolveOptions()
+    : hasDeadline_(false),
+      deadline_(),
+      maxNodes_(-1),
+      hasCancellation_(false),
+      cancellation_(),
+      allowedCells_() {}
+
+void SolveOptions::setDeadline(const Clock::time_point& deadline) {
+    hasDeadline_ = true;
+    deadline_ = deadline;
+}
+
+void SolveOptions::setTimeBudget(const std::chrono::milliseconds& budget) {
+    setDeadline(Clock::now() + budget);
+}
+
+void SolveOptions::setMaxNodes(long long maxNodes) {
+    maxNodes_ = maxNodes;
+}
+
+void SolveOptions::setCancellationToken(const CancellationToken& token) {
+    hasCancellation_ = true;
+    cancellation_ = token;
+}
+
+void SolveOptions::setAllowedCells(const std::shared_ptr<const std::vector<bool>>& mask) {
+    allowedCells_ = mask;
+}
+
+void SolveOptions::clearLimits() {
+    hasDeadline_ = false;
+    maxNodes_ = -1;
+    hasCancellation_ = false;
+    allowedCells_.reset();
+}
+
+bool SolveOptions::hasDeadline() const {
+    return hasDeadline_;
+}
+
+SolveOptions::Clock::time_point SolveOptions::getDeadline() const {
+    return deadline_;
+}
+
+long long SolveOptions::getMaxNodes() const {
+    return maxNodes_;
+}
+
+bool SolveOptions::hasCancellationToken() const {
+    return hasCancellation_;
+}
+
+const CancellationToken& SolveOptions::getCancellationToken() const {
+    return cancellation_;
+}
+
+bool SolveOptions::hasAllowedCells() const {
+    return static_cast<bool>(allowedCells_);
+}
+
+SolveResult::SolveResult() : status_(SolveStatus::Unreachable), path_() {}
+
+SolveResult::SolveResult(SolveStatus status) : status_(status), path_() {}
+
+SolveResult::SolveResult(SolveStatus status, const Path& path) : status_(status), path_(path) {}
+
+SolveStatus SolveResult::getStatus() const {
+    return status_;
+}
+
+const Path& SolveResult::getPath() const {
+    return path_;
+}
+
+bool SolveResult::isFound() const {
+    return status_ == SolveStatus::Found;
+}
+
+SolveBudget::SolveBudget(const SolveOptions& options)
+    : options_(options), nodes_(0), untilCheck_(1), stopStatus_(SolveStatus::Found) {}
+
+bool SolveBudget::checkSlowLimits() {
+    if (options_.hasCancellationToken() && options_.getCancellationToken().isCancelled()) {
+        stopStatus_ = SolveStatus::Cancelled;
+        return false;
+    }
+    if (options_.hasDeadline() && SolveOptions::Clock::now() >= options_.getDeadline()) {
+        stopStatus_ = SolveStatus::BudgetExceeded;
+        return false;
+    }
+    return true;
+}
+
+long long SolveBudget::getNodesConsumed() const {
+    return nodes_;
+}
+
+SolveStatus SolveBudget::getStopStatus() const {
+    return stopStatus_;
+}
@@ -0,0 +1,250 @@
+#include "SolverPlanner.h"
+
+#include "AStarSolver.h"
+#include "PerfectMazeIndex.h"
+#include "SolverKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    const int kDx[4] = {0, 1, 0, -1};
+    const int kDy[4] = {-1, 0, 1, 0};
+
+    std::string formatNumber(double value, int precision) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(precision) << value;
+        return out.str();
+    }
+
+    void addCandidate(std::vector<SolverEngine>& candidates, SolverEngine engine) {
+        if (std::find(candidates.begin(), candidates.end(), engine) == candidates.end()) {
+            candidates.push_back(engine);
+        }
+    }
+}
+
+std::string solverEngineName(SolverEngine engine) {
+    switch (engine) {
+        case SolverEngine::TreeIndex:
+            return "tree index";
+        case SolverEngine::BreadthFirst:
+            return "BFS kernel";
+        case SolverEngine::BucketDijkstra:
+            return "bucket Dijkstra";
+        case SolverEngine::Dijkstra:
+            return "Dijkstra kernel";
+        case SolverEngine::AStar:
+            return "A*";
+    }
+    return "unknown";
+}
+
+std::unique_ptr<MazeSolverStrategy> createSolver(SolverEngine engine) {
+    switch (engine) {
+        case SolverEngine::TreeIndex:
+            return std::unique_ptr<MazeSolverStrategy>(new TreeIndexSolver());
+        case SolverEngine::BreadthFirst:
+            return std::unique_ptr<MazeSolverStrategy>(new FastBFSSolver());
+        case SolverEngine::BucketDijkstra:
+            return std::unique_ptr<MazeSolverStrategy>(new BucketDijkstraSolver());
+        case SolverEngine::Dijkstra:
+            return std::unique_ptr<MazeSolverStrategy>(new FastDijkstraSolver());
+        case SolverEngine::AStar:
+            return std::unique_ptr<MazeSolverStrategy>(new AStarSolver());
+    }
+    return std::unique_ptr<MazeSolverStrategy>(new FastDijkstraSolver());
+}
+
+double MazeProfile::getLoopDensity() const {
+    return openCells > 0 ? static_cast<double>(loops) / static_cast<double>(openCells) : 0.0;
+}
+
+double MazeProfile::getCostRatio() const {
+    return meanCost > 0.0 ? minimumCost / meanCost : 0.0;
+}
+
+SolverPlan::SolverPlan() : profile_(), candidates_(), reasons_() {}
+
+const MazeProfile& SolverPlan::getProfile() const {
+    return profile_;
+}
+
+SolverEngine SolverPlan::getEngine() const {
+    return candidates_.empty() ? SolverEngine::Dijkstra : candidates_.front();
+}
+
+const std::vector<SolverEngine>& SolverPlan::getCandidates() const {
+    return candidates_;
+}
+
+const std::vector<std::string>& SolverPlan::getReasons() const {
+    return reasons_;
+}
+
+std::unique_ptr<MazeSolverStrategy> SolverPlan::createStrategy() const {
+    return createSolver(getEngine());
+}
+
+void SolverPlan::display() const {
+    std::cout << *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const SolverPlan& plan) {
+    const MazeProfile& p = plan.profile_;
+    os << "Maze:        " << p.width << "x" << p.height << ", " << p.openCells << " open cells, "
+       << p.components << " component(s), " << p.loops << " loop(s)\n"
+       << "Costs:       " << (p.uniformCosts ? "uniform" : "weighted")
+       << (p.integerCosts ? ", integer" : "") << ", min " << p.minimumCost
+       << ", max " << p.maximumCost << ", mean " << formatNumber(p.meanCost, 2) << "\n"
+       << "Engine:      " << solverEngineName(plan.getEngine()) << "\n";
+    for (const auto& reason : plan.reasons_) {
+        os << "  - " << reason << "\n";
+    }
+    return os;
+}
+
+SolverPlanner::SolverPlanner() : minLoopDensity_(0.05), minCostRatio_(0.5), maxBucketCost_(8) {}
+
+void SolverPlanner::setMinLoopDensity(double density) {
+    minLoopDensity_ = density;
+}
+
+void SolverPlanner::setMinCostRatio(double ratio) {
+    minCostRatio_ = ratio;
+}
+
+void SolverPlanner::setMaxBucketCost(int cost) {
+    maxBucketCost_ = cost;
+}
+
+MazeProfile SolverPlanner::profile(const Maze& maze) const {
+    MazeProfile profile;
+    profile.width = maze.getWidth();
+    profile.height = maze.getHeight();
+
+    const int width = profile.width;
+    const int height = profile.height;
+    const CostModel& model = maze.getCostModel();
+
+    std::vector<bool> open(static_cast<std::size_t>(width * height), false);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            char cell = maze.getCellAt(x, y);
+            profile.terrainCounts[static_cast<unsigned char>(cell)]++;
+            if (!model.isPassable(cell)) continue;
+
+            open[static_cast<std::size_t>(y * width + x)] = true;
+            profile.openCells++;
+            if (x + 1 < width && model.isPassable(maze.getCellAt(x + 1, y))) profile.edges++;
+            if (y + 1 < height && model.isPassable(maze.getCellAt(x, y + 1))) profile.edges++;
+        }
+    }
+
+    double totalCost = 0.0;
+    bool first = true;
+    for (int c = 0; c < 256; c++) {
+        long long count = profile.terrainCounts[c];
+        double cost = model.getCost(static_cast<char>(c));
+        if (count == 0 || cost == CostModel::impassable()) continue;
+
+        if (first) {
+            profile.minimumCost = cost;
+            profile.maximumCost = cost;
+            first = false;
+        }
+        profile.minimumCost = std::min(profile.minimumCost, cost);
+        profile.maximumCost = std::max(profile.maximumCost, cost);
+        totalCost += cost * static_cast<double>(count);
+        if (cost != std::floor(cost)) profile.integerCosts = false;
+    }
+    profile.uniformCosts = profile.minimumCost == profile.maximumCost;
+    profile.meanCost = profile.openCells > 0 ? totalCost / static_cast<double>(profile.openCells) : 0.0;
+
+    std::vector<int> stack;
+    for (int start = 0; start < width * height; start++) {
+        if (!open[static_cast<std::size_t>(start)]) continue;
+
+        profile.components++;
+        open[static_cast<std::size_t>(start)] = false;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            for (int k = 0; k < 4; k++) {
+                int nx = cell % width + kDx[k];
+                int ny = cell / width + kDy[k];
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                std::size_t next = static_cast<std::size_t>(ny * width + nx);
+                if (!open[next]) continue;
+                open[next] = false;
+                stack.push_back(static_cast<int>(next));
+            }
+        }
+    }
+    // Cycle rank of the grid graph: independent loops across all components.
+    profile.loops = profile.edges - profile.openCells + profile.components;
+
+    profile.connected = maze.areConnected(maze.getStart(), maze.getGoal());
+    profile.manhattanDistance = maze.getStart().manhattanDistance(maze.getGoal());
+    return profile;
+}
+
+SolverPlan SolverPlanner::plan(const Maze& maze) const {
+    SolverPlan plan;
+    plan.profile_ = profile(maze);
+    const MazeProfile& p = plan.profile_;
+    std::vector<SolverEngine>& candidates = plan.candidates_;
+    std::vector<std::string>& reasons = plan.reasons_;
+
+    if (!p.connected) {
+        reasons.push_back("start and goal are in different components; every engine rejects the query "
+                          "up front, so the cheapest one is used");
+        candidates.push_back(SolverEngine::BreadthFirst);
+        return plan;
+    }
+
+    // A fresh solver answers one query, and the tree index needs an
+    // O(N log N) build before its first answer, so it never leads.
+    const bool forest = p.loops == 0;
+    if (forest) {
+        reasons.push_back("no loops: the path is unique, but building the tree index costs more than one "
+                          "search, so it ranks last and only pays off over repeated queries");
+    }
+
+    if (p.uniformCosts) {
+        reasons.push_back("all walkable terrain costs " + formatNumber(p.minimumCost, 2) +
+                          ", so breadth-first order is already optimal");
+        addCandidate(candidates, SolverEngine::BreadthFirst);
+        addCandidate(candidates, SolverEngine::AStar);
+        if (forest) addCandidate(candidates, SolverEngine::TreeIndex);
+        return plan;
+    }
+
+    bool informative = p.getCostRatio() >= minCostRatio_ && p.getLoopDensity() >= minLoopDensity_;
+    bool bucketable = p.integerCosts && p.maximumCost <= static_cast<double>(maxBucketCost_);
+
+    if (informative) {
+        reasons.push_back("heuristic is informative: min/mean cost ratio " + formatNumber(p.getCostRatio(), 2) +
+                          " and loop density " + formatNumber(p.getLoopDensity(), 3) +
+                          " leave the maze open enough for Manhattan guidance");
+        addCandidate(candidates, SolverEngine::AStar);
+    } else {
+        reasons.push_back("heuristic is weak: min/mean cost ratio " + formatNumber(p.getCostRatio(), 2) +
+                          ", loop density " + formatNumber(p.getLoopDensity(), 3));
+    }
+
+    if (bucketable) {
+        reasons.push_back("integer costs up to " + formatNumber(p.maximumCost, 0) +
+                          " fit a bucket queue of " + std::to_string(maxBucketCost_ + 1) + " slots");
+        addCandidate(candidates, SolverEngine::BucketDijkstra);
+    } else {
+        reasons.push_back(p.integerCosts ? "costs exceed the bucket queue range" : "fractional costs rule out buckets");
+    }
+
+    addCandidate(candidates, SolverEngine::Dijkstra);
+    addCandidate(candidates, SolverEngine::AStar);
+    if (forest) addCandidate(candidates, SolverEngine::TreeIndex);
+    return plan;
+}
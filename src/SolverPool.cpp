@@ -0,0 +1,218 @@
+#include "SolverPool.h"
+
+#include "Exceptions.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+struct SolveJob {
+    std::shared_ptr<const Maze> maze;
+    std::unique_ptr<MazeSolverStrategy> strategy;
+    SolveOptions options;
+    CancellationToken token;
+    std::string strategyName;
+    std::function<void()> onFinished;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    SolveResult result;
+    std::exception_ptr error;
+    int nodesExplored = 0;
+    double elapsedMillis = 0.0;
+};
+
+namespace {
+    void completeJob(SolveJob& job, const SolveResult& result, int nodes, double millis,
+                     std::exception_ptr error) {
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.result = result;
+            job.nodesExplored = nodes;
+            job.elapsedMillis = millis;
+            job.error = error;
+            job.done = true;
+        }
+        job.finished.notify_all();
+        // The snapshot and strategy are no longer needed once the result is
+        // published; handles can outlive the maze by a long way.
+        job.strategy.reset();
+        job.maze.reset();
+        if (job.onFinished) {
+            job.onFinished();
+            job.onFinished = std::function<void()>();
+        }
+    }
+}
+
+SolveHandle::SolveHandle() : job_() {}
+
+SolveHandle::SolveHandle(const std::shared_ptr<SolveJob>& job) : job_(job) {}
+
+bool SolveHandle::isValid() const {
+    return static_cast<bool>(job_);
+}
+
+bool SolveHandle::isReady() const {
+    if (!job_) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(job_->mutex);
+    return job_->done;
+}
+
+void SolveHandle::wait() const {
+    if (!job_) {
+        throw MazeException("Waiting on an empty solve handle");
+    }
+    std::unique_lock<std::mutex> lock(job_->mutex);
+    job_->finished.wait(lock, [this] { return job_->done; });
+}
+
+bool SolveHandle::waitFor(const std::chrono::milliseconds& timeout) const {
+    if (!job_) {
+        throw MazeException("Waiting on an empty solve handle");
+    }
+    std::unique_lock<std::mutex> lock(job_->mutex);
+    return job_->finished.wait_for(lock, timeout, [this] { return job_->done; });
+}
+
+void SolveHandle::cancel() const {
+    if (job_) {
+        job_->token.cancel();
+    }
+}
+
+SolveResult SolveHandle::getResult() const {
+    wait();
+    std::lock_guard<std::mutex> lock(job_->mutex);
+    if (job_->error) {
+        std::rethrow_exception(job_->error);
+    }
+    return job_->result;
+}
+
+int SolveHandle::getNodesExplored() const {
+    wait();
+    std::lock_guard<std::mutex> lock(job_->mutex);
+    return job_->nodesExplored;
+}
+
+double SolveHandle::getElapsedMillis() const {
+    wait();
+    std::lock_guard<std::mutex> lock(job_->mutex);
+    return job_->elapsedMillis;
+}
+
+std::string SolveHandle::getStrategyName() const {
+    return job_ ? job_->strategyName : std::string();
+}
+
+SolverPool::SolverPool(int threads) : workers_(), queue_(), mutex_(), available_(), stopping_(false) {
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    workers_.reserve(static_cast<std::size_t>(threads));
+    for (int i = 0; i < threads; i++) {
+        workers_.emplace_back(&SolverPool::workerLoop, this);
+    }
+}
+
+SolverPool::~SolverPool() {
+    std::deque<std::shared_ptr<SolveJob>> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        abandoned.swap(queue_);
+    }
+    available_.notify_all();
+
+    for (auto& job : abandoned) {
+        job->token.cancel();
+        completeJob(*job, SolveResult(SolveStatus::Cancelled), 0, 0.0, std::exception_ptr());
+    }
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+SolverPool& SolverPool::shared() {
+    static SolverPool pool;
+    return pool;
+}
+
+SolveHandle SolverPool::submit(const std::shared_ptr<const Maze>& maze,
+                               std::unique_ptr<MazeSolverStrategy> strategy,
+                               const SolveOptions& options,
+                               const std::function<void()>& onFinished) {
+    if (!maze || !strategy) {
+        throw MazeException("Solve job needs both a maze and a strategy");
+    }
+
+    std::shared_ptr<SolveJob> job = std::make_shared<SolveJob>();
+    job->maze = maze;
+    job->strategyName = strategy->name();
+    job->strategy = std::move(strategy);
+    job->options = options;
+    job->onFinished = onFinished;
+    if (options.hasCancellationToken()) {
+        job->token = options.getCancellationToken();
+    } else {
+        job->options.setCancellationToken(job->token);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            throw MazeException("Solver pool is shutting down");
+        }
+        queue_.push_back(job);
+    }
+    available_.notify_one();
+    return SolveHandle(job);
+}
+
+void SolverPool::workerLoop() {
+    while (true) {
+        std::shared_ptr<SolveJob> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            available_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            job = queue_.front();
+            queue_.pop_front();
+        }
+        runJob(*job);
+    }
+}
+
+void SolverPool::runJob(SolveJob& job) {
+    if (job.token.isCancelled()) {
+        completeJob(job, SolveResult(SolveStatus::Cancelled), 0, 0.0, std::exception_ptr());
+        return;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    SolveResult result;
+    int nodes = 0;
+    std::exception_ptr error;
+    try {
+        result = job.strategy->solveWithOptions(*job.maze, job.options);
+        nodes = job.strategy->getNodesExplored();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    completeJob(job, result, nodes, millis, error);
+}
+
+int SolverPool::getThreadCount() const {
+    return static_cast<int>(workers_.size());
+}
+
+int SolverPool::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(queue_.size());
+}
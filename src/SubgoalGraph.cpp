@@ -0,0 +1,327 @@
+#include "SubgoalGraph.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+    const int kQuadrants[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    typedef std::pair<double, int> QueueItem;
+}
+
+SubgoalGraph::SubgoalGraph()
+    : width_(0), height_(0), revision_(0), built_(false), generation_(0) {}
+
+// A convex corner: the diagonal cell is blocked but both cells that step
+// around it are open, so a taut path around that wall must bend here.
+bool SubgoalGraph::isCorner(const Maze& maze, int x, int y) const {
+    for (const auto& q : kQuadrants) {
+        if (!maze.isWalkable(Point(x + q[0], y + q[1])) &&
+            maze.isWalkable(Point(x + q[0], y)) &&
+            maze.isWalkable(Point(x, y + q[1]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SubgoalGraph::distance(int a, int b) const {
+    return std::abs(a % width_ - b % width_) + std::abs(a / width_ - b / width_);
+}
+
+// Collects the subgoals reachable from origin by a monotone (Manhattan
+// length) path that passes through no other subgoal. Each quadrant is swept
+// outward one step at a time and the sweep never expands past a subgoal.
+void SubgoalGraph::findDirect(const Maze& maze, int origin, int target,
+                              std::vector<int>& subgoals, bool& reachedTarget) const {
+    subgoals.clear();
+    reachedTarget = origin == target;
+
+    if (++generation_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        generation_ = 1;
+    }
+    stamp_[static_cast<std::size_t>(origin)] = generation_;
+
+    for (const auto& q : kQuadrants) {
+        frontier_.clear();
+        frontier_.push_back(origin);
+
+        for (std::size_t head = 0; head < frontier_.size(); head++) {
+            int cell = frontier_[head];
+            int x = cell % width_;
+            int y = cell / width_;
+
+            const int steps[2][2] = {{x + q[0], y}, {x, y + q[1]}};
+            for (const auto& step : steps) {
+                Point next(step[0], step[1]);
+                if (!maze.isWalkable(next)) continue;
+
+                int nextCell = next.getY() * width_ + next.getX();
+                if (nextCell == target) {
+                    reachedTarget = true;
+                }
+                if (stamp_[static_cast<std::size_t>(nextCell)] == generation_) continue;
+                stamp_[static_cast<std::size_t>(nextCell)] = generation_;
+
+                if (subgoalOfCell_[static_cast<std::size_t>(nextCell)] >= 0) {
+                    subgoals.push_back(subgoalOfCell_[static_cast<std::size_t>(nextCell)]);
+                } else {
+                    frontier_.push_back(nextCell);
+                }
+            }
+        }
+
+        // Cells on the shared axis belong to two quadrants; clear their
+        // stamps so the next sweep can pass through them again.
+        for (int cell : frontier_) {
+            if (cell != origin && (cell % width_ == origin % width_ || cell / width_ == origin / width_)) {
+                stamp_[static_cast<std::size_t>(cell)] = 0;
+            }
+        }
+    }
+
+    std::sort(subgoals.begin(), subgoals.end());
+    subgoals.erase(std::unique(subgoals.begin(), subgoals.end()), subgoals.end());
+}
+
+bool SubgoalGraph::build(const Maze& maze) {
+    // Subgoals only make sense when every step costs the same; terrain
+    // mazes are left to Dijkstra.
+    clear();
+    if (!maze.hasUniformCosts()) {
+        return false;
+    }
+
+    width_ = maze.getWidth();
+    height_ = maze.getHeight();
+    revision_ = maze.getRevision();
+    std::size_t cells = static_cast<std::size_t>(width_ * height_);
+    subgoalOfCell_.assign(cells, -1);
+    stamp_.assign(cells, 0);
+    generation_ = 0;
+
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            if (maze.isWalkable(Point(x, y)) && isCorner(maze, x, y)) {
+                int cell = y * width_ + x;
+                subgoalOfCell_[static_cast<std::size_t>(cell)] = static_cast<int>(subgoalCells_.size());
+                subgoalCells_.push_back(cell);
+            }
+        }
+    }
+
+    std::vector<int> direct;
+    bool unused = false;
+    edgeOffsets_.push_back(0);
+    for (int cell : subgoalCells_) {
+        findDirect(maze, cell, -1, direct, unused);
+        edgeTargets_.insert(edgeTargets_.end(), direct.begin(), direct.end());
+        edgeOffsets_.push_back(static_cast<int>(edgeTargets_.size()));
+    }
+
+    built_ = true;
+    return true;
+}
+
+bool SubgoalGraph::isBuilt() const {
+    return built_;
+}
+
+bool SubgoalGraph::matches(const Maze& maze) const {
+    return built_ && maze.getRevision() == revision_ && maze.getWidth() == width_ && maze.getHeight() == height_;
+}
+
+void SubgoalGraph::clear() {
+    width_ = 0;
+    height_ = 0;
+    revision_ = 0;
+    built_ = false;
+    subgoalOfCell_.clear();
+    subgoalCells_.clear();
+    edgeOffsets_.clear();
+    edgeTargets_.clear();
+    stamp_.clear();
+    frontier_.clear();
+}
+
+int SubgoalGraph::getSubgoalCount() const {
+    return static_cast<int>(subgoalCells_.size());
+}
+
+int SubgoalGraph::getEdgeCount() const {
+    return static_cast<int>(edgeTargets_.size());
+}
+
+// Rebuilds one monotone segment: a reachability sweep over the bounding box
+// from `from`, then a walk back from `to` through reachable cells.
+void SubgoalGraph::appendSegment(const Maze& maze, int from, int to, Path& path) const {
+    int fx = from % width_, fy = from / width_;
+    int tx = to % width_, ty = to / width_;
+    int sx = tx >= fx ? 1 : -1;
+    int sy = ty >= fy ? 1 : -1;
+    int w = std::abs(tx - fx) + 1;
+    int h = std::abs(ty - fy) + 1;
+
+    std::vector<char> reach(static_cast<std::size_t>(w * h), 0);
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            if (!maze.isWalkable(Point(fx + i * sx, fy + j * sy))) continue;
+            bool ok = (i == 0 && j == 0) ||
+                      (i > 0 && reach[static_cast<std::size_t>(j * w + i - 1)]) ||
+                      (j > 0 && reach[static_cast<std::size_t>((j - 1) * w + i)]);
+            reach[static_cast<std::size_t>(j * w + i)] = ok ? 1 : 0;
+        }
+    }
+
+    std::vector<Point> reverse;
+    int i = w - 1, j = h - 1;
+    while (i > 0 || j > 0) {
+        reverse.push_back(Point(fx + i * sx, fy + j * sy));
+        if (i > 0 && reach[static_cast<std::size_t>(j * w + i - 1)]) {
+            i--;
+        } else {
+            j--;
+        }
+    }
+    for (auto it = reverse.rbegin(); it != reverse.rend(); ++it) {
+        path.addPoint(*it);
+    }
+}
+
+SolveResult SubgoalGraph::findPath(const Maze& maze, const Point& start, const Point& goal,
+                                   const SolveOptions& options, int& nodesExplored) const {
+    nodesExplored = 0;
+    if (!built_ || !maze.areConnected(start, goal)) {
+        return SolveResult(SolveStatus::Unreachable);
+    }
+
+    const int startCell = start.getY() * width_ + start.getX();
+    const int goalCell = goal.getY() * width_ + goal.getX();
+    const int subgoals = static_cast<int>(subgoalCells_.size());
+    const int startNode = subgoals;
+    const int goalNode = subgoals + 1;
+
+    std::vector<int> startLinks;
+    std::vector<int> goalLinks;
+    bool direct = false;
+    bool unused = false;
+    findDirect(maze, startCell, goalCell, startLinks, direct);
+
+    std::vector<int> parent;
+    std::vector<int> order;
+    if (!direct) {
+        findDirect(maze, goalCell, -1, goalLinks, unused);
+
+        std::vector<char> linksToGoal(static_cast<std::size_t>(subgoals), 0);
+        for (int s : goalLinks) linksToGoal[static_cast<std::size_t>(s)] = 1;
+
+        auto cellOf = [&](int node) {
+            return node == startNode ? startCell : (node == goalNode ? goalCell : subgoalCells_[static_cast<std::size_t>(node)]);
+        };
+
+        std::vector<int> g(static_cast<std::size_t>(subgoals + 2), -1);
+        parent.assign(static_cast<std::size_t>(subgoals + 2), -1);
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+        g[static_cast<std::size_t>(startNode)] = 0;
+        open.push(QueueItem(distance(startCell, goalCell), startNode));
+
+        SolveBudget budget(options);
+        bool found = false;
+        while (!open.empty()) {
+            QueueItem top = open.top();
+            open.pop();
+            int u = top.second;
+            int gu = g[static_cast<std::size_t>(u)];
+            if (top.first > gu + distance(cellOf(u), goalCell)) continue;
+
+            if (!budget.consume()) {
+                return SolveResult(budget.getStopStatus());
+            }
+            nodesExplored++;
+
+            if (u == goalNode) {
+                found = true;
+                break;
+            }
+
+            auto relax = [&](int v) {
+                int candidate = gu + distance(cellOf(u), cellOf(v));
+                int& gv = g[static_cast<std::size_t>(v)];
+                if (gv < 0 || candidate < gv) {
+                    gv = candidate;
+                    parent[static_cast<std::size_t>(v)] = u;
+                    open.push(QueueItem(candidate + distance(cellOf(v), goalCell), v));
+                }
+            };
+
+            if (u == startNode) {
+                for (int v : startLinks) relax(v);
+            } else {
+                for (int e = edgeOffsets_[static_cast<std::size_t>(u)]; e < edgeOffsets_[static_cast<std::size_t>(u) + 1]; e++) {
+                    relax(edgeTargets_[static_cast<std::size_t>(e)]);
+                }
+                if (linksToGoal[static_cast<std::size_t>(u)]) relax(goalNode);
+            }
+        }
+
+        if (!found) {
+            return SolveResult(SolveStatus::Unreachable);
+        }
+        for (int node = goalNode; node != -1; node = parent[static_cast<std::size_t>(node)]) {
+            order.push_back(cellOf(node));
+        }
+        std::reverse(order.begin(), order.end());
+    } else {
+        order.push_back(startCell);
+        order.push_back(goalCell);
+    }
+
+    Path path;
+    path.addPoint(start);
+    for (std::size_t k = 1; k < order.size(); k++) {
+        appendSegment(maze, order[k - 1], order[k], path);
+    }
+    // Costs are uniform, so every step costs what the start cell does.
+    path.setCost(maze.getCellCost(start) * (path.getSize() - 1));
+    return SolveResult(SolveStatus::Found, path);
+}
+
+SubgoalSolver::SubgoalSolver() : graph_(), fallback_(), nodesExplored_(0), usedFallback_(false) {}
+
+bool SubgoalSolver::prepare(const Maze& maze) {
+    return graph_.build(maze);
+}
+
+const SubgoalGraph& SubgoalSolver::getGraph() const {
+    return graph_;
+}
+
+bool SubgoalSolver::usedFallback() const {
+    return usedFallback_;
+}
+
+SolveResult SubgoalSolver::solveWithOptions(const Maze& maze, const SolveOptions& options) {
+    // Subgoal links are straight-line reachability over the whole maze, so a
+    // restricted search goes to Dijkstra.
+    if (options.hasAllowedCells() || (!graph_.matches(maze) && !prepare(maze))) {
+        usedFallback_ = true;
+        SolveResult result = fallback_.solveWithOptions(maze, options);
+        nodesExplored_ = fallback_.getNodesExplored();
+        return result;
+    }
+
+    usedFallback_ = false;
+    return graph_.findPath(maze, maze.getStart(), maze.getGoal(), options, nodesExplored_);
+}
+
+int SubgoalSolver::getNodesExplored() const {
+    return nodesExplored_;
+}
+
+std::string SubgoalSolver::name() const {
+    return "Subgoal Graph";
+}
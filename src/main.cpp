@@ -9,6 +9,9 @@
 #include "CLIUtils.h"
 #include "GameMode.h"
 #include "MazeSolverStrategy.h"
+#include "PortfolioRunner.h"
+#include "SolverPlanner.h"
+#include "SolverPool.h"
 #include "Exceptions.h"
 #include <iostream>
 #include <ctime>
@@ -22,6 +25,7 @@
 class MazeSolverApp {
 private:
     Maze maze_;
+    std::shared_ptr<const Maze> snapshot_;
     Path bfsPath_;
     Path dijkstraPath_;
     bool mazeLoaded_;
@@ -46,6 +50,7 @@ private:
     void handlePlayGame();
     void handleSettings();
     void applyActiveThemeToCLI();
+    std::shared_ptr<const Maze> mazeSnapshot();
     
 public:
     MazeSolverApp();
@@ -689,6 +694,16 @@ void MazeSolverApp::handleGenerateMaze() {
     cli_.waitForEnter();
 }
 
+// Pool jobs read a shared copy of the maze. It is taken once per maze
+// state rather than once per solve.
+std::shared_ptr<const Maze> MazeSolverApp::mazeSnapshot() {
+    if (!snapshot_ || snapshot_->getRevision() != maze_.getRevision() ||
+        snapshot_->getStart() != maze_.getStart() || snapshot_->getGoal() != maze_.getGoal()) {
+        snapshot_ = std::make_shared<const Maze>(maze_);
+    }
+    return snapshot_;
+}
+
 void MazeSolverApp::handleSolveBFS() {
     if (!mazeLoaded_) {
         cli_.printError("Please load or generate a maze first!");
@@ -700,16 +715,16 @@ void MazeSolverApp::handleSolveBFS() {
     cli_.printHeader("BFS Solver");
     
     std::cout << "\n";
-    BFSSolver solver;
+    SolveHandle handle = SolverPool::shared().submit(
+        mazeSnapshot(), std::unique_ptr<MazeSolverStrategy>(new BFSSolver()));
     
-    for (int i = 0; i < 20; i++) {
+    for (int i = 0; !handle.waitFor(std::chrono::milliseconds(30)); i++) {
         cli_.drawSpinner(i);
         std::cout << " Exploring maze with BFS...\r";
         std::cout.flush();
-        usleep(30000);
     }
     
-    bfsPath_ = solver.solve(maze_);
+    bfsPath_ = handle.getResult().getPath();
     
     std::cout << "\n";
     if (bfsPath_.isEmpty()) {
@@ -719,7 +734,7 @@ void MazeSolverApp::handleSolveBFS() {
         std::cout << "\n";
         int bfsSteps = std::max(0, bfsPath_.getSize() - 1);
         std::cout << "  Path length: " << bfsSteps << " steps\n";
-        std::cout << "  Nodes explored: " << solver.getNodesExplored() << "\n";
+        std::cout << "  Nodes explored: " << handle.getNodesExplored() << "\n";
         
         PathAnalyzer quickAnalyzer;
         PathMetrics quickMetrics = quickAnalyzer.analyze(bfsPath_, maze_);
@@ -746,16 +761,16 @@ void MazeSolverApp::handleSolveDijkstra() {
     cli_.printHeader("Dijkstra Solver");
     
     std::cout << "\n";
-    DijkstraSolver solver;
+    SolveHandle handle = SolverPool::shared().submit(
+        mazeSnapshot(), std::unique_ptr<MazeSolverStrategy>(new DijkstraSolver()));
     
-    for (int i = 0; i < 20; i++) {
+    for (int i = 0; !handle.waitFor(std::chrono::milliseconds(30)); i++) {
         cli_.drawSpinner(i);
         std::cout << " Finding optimal path with Dijkstra...\r";
         std::cout.flush();
-        usleep(30000);
     }
     
-    dijkstraPath_ = solver.solve(maze_);
+    dijkstraPath_ = handle.getResult().getPath();
     
     std::cout << "\n";
     if (dijkstraPath_.isEmpty()) {
@@ -765,7 +780,7 @@ void MazeSolverApp::handleSolveDijkstra() {
         std::cout << "\n";
         int dijkstraSteps = std::max(0, dijkstraPath_.getSize() - 1);
         std::cout << "  Path length: " << dijkstraSteps << " steps\n";
-        std::cout << "  Nodes explored: " << solver.getNodesExplored() << "\n";
+        std::cout << "  Nodes explored: " << handle.getNodesExplored() << "\n";
         
         PathAnalyzer quickAnalyzer;
         PathMetrics quickMetrics = quickAnalyzer.analyze(dijkstraPath_, maze_);
@@ -923,56 +938,53 @@ void MazeSolverApp::handleQuickSolve() {
     
     std::cout << "\n";
 
-    std::vector<std::unique_ptr<MazeSolverStrategy>> strategies;
-    strategies.emplace_back(std::unique_ptr<MazeSolverStrategy>(new BFSSolver()));
-    strategies.emplace_back(std::unique_ptr<MazeSolverStrategy>(new DijkstraSolver()));
-
-    for (auto& strategy : strategies) {
-        const std::string solverName = strategy->name();
-        const std::string infoMessage = "Solving with " + solverName + "...";
-        cli_.printInfo(infoMessage.c_str());
+    SolverPlanner planner;
+    SolverPlan plan = planner.plan(maze_);
+    cli_.printSubHeader("Solver Plan");
+    plan.display();
+    std::cout << "\n";
 
-        Path solvedPath = strategy->solve(maze_);
+    PortfolioRunner portfolio;
+    portfolio.addEngines(plan.getCandidates());
+    const std::string infoMessage = "Racing " + std::to_string(portfolio.getStrategyCount()) +
+                                    " planned solver(s)...";
+    cli_.printInfo(infoMessage.c_str());
 
-        if (solvedPath.isEmpty()) {
-            const std::string warnMessage = solverName + " could not find a path.";
-            cli_.printWarning(warnMessage.c_str());
-            continue;
-        }
-
-        const std::string successMessage = solverName + " complete!";
-        cli_.printSuccess(successMessage.c_str());
-        std::cout << "  Path length: " << std::max(0, solvedPath.getSize() - 1) << " steps\n";
-        std::cout << "  Nodes explored: " << strategy->getNodesExplored() << "\n";
-        
-        PathAnalyzer quickAnalyzer;
-        PathMetrics quickMetrics = quickAnalyzer.analyze(solvedPath, maze_);
-        std::cout << "  Cost (with turn penalty): " << quickMetrics.getTotalCostWithPenalty() << "\n\n";
+    PortfolioResult race = portfolio.run(mazeSnapshot());
+    race.display();
+    std::cout << "\n";
 
-        if (solverName.find("Breadth") != std::string::npos) {
-            bfsPath_ = solvedPath;
-            bfsSolved_ = true;
-        } else {
-            dijkstraPath_ = solvedPath;
-            dijkstraSolved_ = true;
-        }
+    if (!race.hasWinner() || !race.getWinner().result.isFound()) {
+        const std::string warnMessage = race.hasWinner()
+            ? "The goal is unreachable."
+            : "No solver produced a result.";
+        cli_.printWarning(warnMessage.c_str());
+        cli_.waitForEnter();
+        return;
     }
-    
-    std::cout << "\n";
-    cli_.printHeader("Results");
-    
-    int bfsSteps = std::max(0, bfsPath_.getSize() - 1);
-    int dijkstraSteps = std::max(0, dijkstraPath_.getSize() - 1);
 
-    PathAnalyzer bfsAnalyzer, dijkstraAnalyzer;
-    PathMetrics bfsMetrics = bfsAnalyzer.analyze(bfsPath_, maze_);
-    PathMetrics dijkstraMetrics = dijkstraAnalyzer.analyze(dijkstraPath_, maze_);
+    const PortfolioEntry& winner = race.getWinner();
+    const Path& solvedPath = winner.result.getPath();
+    const std::string successMessage = winner.name + " finished first!";
+    cli_.printSuccess(successMessage.c_str());
+    std::cout << "  Path length: " << std::max(0, solvedPath.getSize() - 1) << " steps\n";
+    std::cout << "  Nodes explored: " << winner.nodesExplored << "\n";
+
+    PathAnalyzer quickAnalyzer;
+    PathMetrics quickMetrics = quickAnalyzer.analyze(solvedPath, maze_);
+    std::cout << "  Cost (with turn penalty): " << quickMetrics.getTotalCostWithPenalty() << "\n\n";
+
+    // Every planned engine is cost-optimal; with uniform costs (or a tree)
+    // the same path is also a shortest path by steps.
+    dijkstraPath_ = solvedPath;
+    dijkstraSolved_ = true;
+    if (plan.getProfile().uniformCosts || plan.getProfile().loops == 0) {
+        bfsPath_ = solvedPath;
+        bfsSolved_ = true;
+    }
 
-    std::cout << "\n  BFS: " << bfsSteps << " steps, cost " << bfsMetrics.getTotalCostWithPenalty() << "\n";
-    std::cout << "  Dijkstra: " << dijkstraSteps << " steps, cost " << dijkstraMetrics.getTotalCostWithPenalty() << "\n";
-    
-    std::cout << "\n";
-    renderer_.renderComparison(maze_, bfsPath_, dijkstraPath_, "BFS", "Dijkstra");
+    cli_.printSubHeader("Path Preview");
+    renderer_.render(maze_, solvedPath, winner.name);
     
     cli_.waitForEnter();
 }